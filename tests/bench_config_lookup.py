@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+按键路径上的配置读取基准
+
+Every key press in mapping mode goes through
+ContextMenuManager.handle_profile_hotkey_press, which reads the profile
+hotkey with ConfigManager.get_value while none is configured. This times
+that lookup against the old behaviour of parsing config.json on every
+call, on a generated config of typical size.
+
+    python3 tests/bench_config_lookup.py [--keys N] [--calls N]
+
+Needs PyGObject (GLib/Gio) but not Gtk; run from the source root or with
+it on PYTHONPATH.
+"""
+
+import argparse
+import json
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from waydroid_helper.config.file_manager import ConfigManager
+
+# 按键时读取的键，没有配置热键时不存在
+LOOKUP_KEY = "controller.widget_profiles.hotkey"
+
+
+def write_config(config_dir: Path, keys: int) -> None:
+    """生成一个典型大小的配置：若干控件配置和几个嵌套的小节"""
+    config = {
+        "controller": {
+            "clipboard_sync": True,
+            "rtt_probe": {"enabled": True, "interval": 2},
+            "widgets": {
+                f"widget_{index}": {
+                    "x": index * 10,
+                    "y": index * 5,
+                    "key": f"KEY_{index % 26}",
+                    "options": {"sensitivity": 20, "prediction_ms": 0},
+                }
+                for index in range(keys)
+            },
+        },
+        "cage": {"enabled": False},
+    }
+    config_dir.mkdir(parents=True, exist_ok=True)
+    with open(config_dir / ConfigManager.DEFAULT_CONFIG_FILE, "w", encoding="utf-8") as f:
+        json.dump(config, f, indent=2)
+
+
+def file_lookup(config_file: Path, key: str) -> object:
+    """旧的实现：每次读取都解析整个文件"""
+    with open(config_file, encoding="utf-8") as f:
+        current = json.load(f)
+    for part in key.split("."):
+        if not isinstance(current, dict) or part not in current:
+            return None
+        current = current[part]
+    return current
+
+
+def per_call_us(func, calls: int) -> float:
+    start = time.perf_counter()
+    for _ in range(calls):
+        func()
+    return (time.perf_counter() - start) / calls * 1e6
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--keys", type=int, default=50, help="widgets in the generated config")
+    parser.add_argument("--calls", type=int, default=2000)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        config_dir = Path(directory)
+        write_config(config_dir, args.keys)
+        config_file = config_dir / ConfigManager.DEFAULT_CONFIG_FILE
+        manager = ConfigManager(config_dir)
+        # 第一次读取会解析文件，不计入
+        manager.get_value(LOOKUP_KEY)
+
+        size = config_file.stat().st_size
+        file_us = per_call_us(lambda: file_lookup(config_file, LOOKUP_KEY), args.calls)
+        cached_us = per_call_us(lambda: manager.get_value(LOOKUP_KEY), args.calls)
+
+    print(f"config {size} bytes, {args.calls} lookups of {LOOKUP_KEY}")
+    print(f"parse file per call: {file_us:8.2f}us")
+    print(f"ConfigManager:       {cached_us:8.2f}us")
+
+
+if __name__ == "__main__":
+    main()
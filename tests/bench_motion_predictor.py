@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""
+运动预测的回放基准
+
+Replays a synthetic 125Hz pointer trace (smooth strokes with direction
+changes, plus sensor noise) through MotionPredictor and compares each
+output with the true position one lead time later. "raw" is the error of
+sending the sample as is, "predicted" the error of the predictor output.
+
+With --trace the input is a recorded session instead: run the app with
+WAYDROID_HELPER_MOTION_TRACE=/path/to/trace.csv, aim for a while, then
+replay the file. The recorded samples are the reference, and the future
+position is interpolated between them.
+
+    python3 tests/bench_motion_predictor.py [--seed N] [--alpha A] [--beta B] [--trace FILE]
+
+The module is loaded from its file so the benchmark does not need Gtk.
+"""
+
+import argparse
+import bisect
+import importlib.util
+import math
+import random
+from pathlib import Path
+
+_spec = importlib.util.spec_from_file_location(
+    "motion_predictor",
+    Path(__file__).resolve().parent.parent
+    / "waydroid_helper" / "controller" / "core" / "motion_predictor.py",
+)
+assert _spec is not None and _spec.loader is not None
+motion_predictor = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(motion_predictor)
+MotionPredictor = motion_predictor.MotionPredictor
+
+RATE_HZ = 125
+NOISE_PX = 0.5
+
+# (时间, x, y)
+Trace = list[tuple[float, float, float]]
+
+
+def true_trace(seed: int = 0, seconds: float = 60.0) -> Trace:
+    """
+    真实轨迹，每 1ms 一个点
+
+    Strokes of 150-600ms with a sine speed profile (start and stop at rest)
+    at up to 1500px/s in a random direction, separated by short pauses.
+    """
+    rng = random.Random(seed)
+    trace: Trace = []
+    t = x = y = 0.0
+    step = 0.001
+    while t < seconds:
+        duration = rng.uniform(0.15, 0.6)
+        peak = rng.uniform(200.0, 1500.0)
+        angle = rng.uniform(0.0, 2 * math.pi)
+        elapsed = 0.0
+        while elapsed < duration:
+            speed = peak * math.sin(math.pi * elapsed / duration)
+            x += speed * math.cos(angle) * step
+            y += speed * math.sin(angle) * step
+            trace.append((t, x, y))
+            t += step
+            elapsed += step
+        for _ in range(int(rng.uniform(0.0, 0.2) / step)):
+            trace.append((t, x, y))
+            t += step
+    return trace
+
+
+def replay(
+    trace: Trace,
+    lead_ms: float,
+    alpha: float = 0.6,
+    beta: float = 0.2,
+    seed: int = 0,
+) -> tuple[float, float]:
+    """返回 (不预测的平均误差, 预测后的平均误差)，单位像素"""
+    rng = random.Random(seed)
+    predictor = MotionPredictor(lead_time=lead_ms / 1000, alpha=alpha, beta=beta)
+    sample_every = 1000 // RATE_HZ
+    lead_steps = int(round(lead_ms))
+    raw_error = predicted_error = 0.0
+    count = 0
+    for index in range(0, len(trace) - lead_steps, sample_every):
+        t, x, y = trace[index]
+        noisy_x = x + rng.gauss(0.0, NOISE_PX)
+        noisy_y = y + rng.gauss(0.0, NOISE_PX)
+        out_x, out_y = predictor.update(noisy_x, noisy_y, t)
+        _, future_x, future_y = trace[index + lead_steps]
+        raw_error += math.hypot(noisy_x - future_x, noisy_y - future_y)
+        predicted_error += math.hypot(out_x - future_x, out_y - future_y)
+        count += 1
+    return raw_error / count, predicted_error / count
+
+
+def load_trace(path: str | Path) -> Trace:
+    """读取录制的轨迹，按时间排序；格式错误的行被跳过"""
+    trace: Trace = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            try:
+                t, x, y = (float(field) for field in line.split(","))
+            except ValueError:
+                continue
+            trace.append((t, x, y))
+    trace.sort()
+    return trace
+
+
+def replay_recorded(
+    trace: Trace,
+    lead_ms: float,
+    alpha: float = 0.6,
+    beta: float = 0.2,
+) -> tuple[float, float]:
+    """
+    回放录制的轨迹，返回 (不预测的平均误差, 预测后的平均误差)
+
+    Samples whose future position falls in a gap longer than
+    MotionPredictor.MAX_SAMPLE_GAP (the pointer was at rest or the
+    recording paused) are fed but not scored.
+    """
+    predictor = MotionPredictor(lead_time=lead_ms / 1000, alpha=alpha, beta=beta)
+    times = [t for t, _, _ in trace]
+    lead = lead_ms / 1000
+    raw_error = predicted_error = 0.0
+    count = 0
+    for t, x, y in trace:
+        out_x, out_y = predictor.update(x, y, t)
+        index = bisect.bisect_left(times, t + lead)
+        if index == 0 or index >= len(trace):
+            continue
+        t0, x0, y0 = trace[index - 1]
+        t1, x1, y1 = trace[index]
+        if t1 - t0 > MotionPredictor.MAX_SAMPLE_GAP:
+            continue
+        k = 0.0 if t1 == t0 else (t + lead - t0) / (t1 - t0)
+        future_x = x0 + (x1 - x0) * k
+        future_y = y0 + (y1 - y0) * k
+        raw_error += math.hypot(x - future_x, y - future_y)
+        predicted_error += math.hypot(out_x - future_x, out_y - future_y)
+        count += 1
+    if count == 0:
+        return 0.0, 0.0
+    return raw_error / count, predicted_error / count
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--alpha", type=float, default=0.6)
+    parser.add_argument("--beta", type=float, default=0.2)
+    parser.add_argument("--trace", help="recorded trace (CSV: time,x,y)")
+    args = parser.parse_args()
+
+    if args.trace:
+        trace = load_trace(args.trace)
+        print(f"{args.trace}: {len(trace)} samples, alpha {args.alpha}, beta {args.beta}")
+    else:
+        trace = true_trace(args.seed)
+        print(f"{RATE_HZ}Hz replay, noise {NOISE_PX}px, alpha {args.alpha}, beta {args.beta}")
+    for lead_ms in (4, 8, 16, 24, 32):
+        if args.trace:
+            raw, predicted = replay_recorded(trace, lead_ms, args.alpha, args.beta)
+        else:
+            raw, predicted = replay(trace, lead_ms, args.alpha, args.beta, args.seed)
+        print(f"{lead_ms:>3}ms lead: raw {raw:5.2f}px, predicted {predicted:5.2f}px")
+
+
+if __name__ == "__main__":
+    main()
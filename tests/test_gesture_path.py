@@ -0,0 +1,76 @@
+"""
+宏手势路径的测试
+
+Runs without Gtk: gesture_path is loaded from its file, like the motion
+predictor in the replay benchmark.
+"""
+
+import importlib.util
+import unittest
+from pathlib import Path
+
+_spec = importlib.util.spec_from_file_location(
+    "gesture_path",
+    Path(__file__).resolve().parent.parent
+    / "waydroid_helper" / "controller" / "core" / "gesture_path.py",
+)
+assert _spec is not None and _spec.loader is not None
+gesture_path = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(gesture_path)
+
+
+class ParseGestureTest(unittest.TestCase):
+    def test_single_finger(self):
+        self.assertEqual(
+            gesture_path.parse_gesture(["100,200", "300,200", "250"]),
+            ([["100,200", "300,200"]], 0.25, "linear"),
+        )
+
+    def test_fingers_and_easing(self):
+        self.assertEqual(
+            gesture_path.parse_gesture(["0,0", "10,0", "+", "mouse", "0,10", "100", "ease_out"]),
+            ([["0,0", "10,0"], ["mouse", "0,10"]], 0.1, "ease_out"),
+        )
+
+    def test_invalid(self):
+        for args in (
+            [],
+            ["0,0", "10,0"],  # 没有时长
+            ["0,0", "100"],  # 只有一个点
+            ["0,0", "10,0", "+", "100"],  # 空路径
+            ["0,0", "a,b", "100"],
+            ["0,0", "10,0", "1.5"],
+        ):
+            self.assertIsNone(gesture_path.parse_gesture(args), args)
+
+    def test_pinch(self):
+        self.assertEqual(
+            gesture_path.parse_pinch(["500,500", "50", "200", "300", "45", "ease_in"]),
+            ("500,500", 50.0, 200.0, 0.3, 45.0, "ease_in"),
+        )
+        self.assertIsNone(gesture_path.parse_pinch(["500,500", "50", "200"]))
+        self.assertIsNone(gesture_path.parse_pinch(["x", "50", "200", "300"]))
+
+
+class PathSamplerTest(unittest.TestCase):
+    def test_samples_by_arc_length(self):
+        # 第一段长 30，第二段长 10
+        sample = gesture_path.path_sampler([(0.0, 0.0), (30.0, 0.0), (30.0, 10.0)])
+        self.assertEqual(sample(0.0), (0.0, 0.0))
+        self.assertEqual(sample(0.5), (20.0, 0.0))
+        self.assertEqual(sample(0.75), (30.0, 0.0))
+        self.assertEqual(sample(0.875), (30.0, 5.0))
+        self.assertEqual(sample(1.0), (30.0, 10.0))
+
+    def test_zero_length_path(self):
+        sample = gesture_path.path_sampler([(5.0, 5.0), (5.0, 5.0)])
+        self.assertEqual(sample(0.5), (5.0, 5.0))
+
+    def test_easings_keep_the_end_points(self):
+        for name, easing in gesture_path.EASINGS.items():
+            self.assertEqual(easing(0.0), 0.0, name)
+            self.assertEqual(easing(1.0), 1.0, name)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,72 @@
+"""
+持续增长判断的测试
+
+Runs without Gtk: growth is loaded from its file, so the rule the soak
+test relies on is checked even where the soak test itself is skipped.
+"""
+
+import importlib.util
+import unittest
+from pathlib import Path
+from types import SimpleNamespace
+
+_spec = importlib.util.spec_from_file_location(
+    "growth",
+    Path(__file__).resolve().parent.parent
+    / "waydroid_helper" / "controller" / "core" / "growth.py",
+)
+assert _spec is not None and _spec.loader is not None
+growth = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(growth)
+
+TOLERANCES = {"tasks": 2, "handlers": 2}
+
+
+def samples(tasks: list[int], handlers: list[dict[str, int]] | None = None) -> list[SimpleNamespace]:
+    handlers = handlers or [{} for _ in tasks]
+    return [
+        SimpleNamespace(tasks=count, handlers=sum(by_event.values()), handlers_by_event=by_event)
+        for count, by_event in zip(tasks, handlers)
+    ]
+
+
+class GrowthFailuresTest(unittest.TestCase):
+    def test_steady_with_noise_passes(self):
+        tasks = [10, 12, 11, 13, 10, 12, 11, 13, 10, 12]
+        self.assertEqual(growth.growth_failures(samples(tasks), TOLERANCES), [])
+
+    def test_steady_leak_fails(self):
+        # 每次采样多一个任务
+        tasks = list(range(10, 20))
+        failures = growth.growth_failures(samples(tasks), TOLERANCES)
+        self.assertEqual(len(failures), 1)
+        self.assertTrue(failures[0].startswith("tasks grew by"))
+
+    def test_growth_within_tolerance_passes(self):
+        tasks = [10, 10, 10, 10, 11, 11, 11, 12, 12, 12]
+        self.assertEqual(growth.growth_failures(samples(tasks), TOLERANCES), [])
+
+    def test_warmup_is_ignored(self):
+        # 第一次采样之后的一次性缓存不算增长
+        tasks = [0, 0, 30, 30, 30, 30, 30, 30, 30, 30]
+        self.assertEqual(growth.growth_failures(samples(tasks), TOLERANCES), [])
+
+    def test_overlapping_thirds_pass(self):
+        # 均值增长但尾部有样本不高于头部
+        tasks = [10, 20, 10, 20, 10, 20, 10, 25, 10, 25]
+        self.assertEqual(growth.growth_failures(samples(tasks), {"tasks": 1}), [])
+
+    def test_reports_growing_event(self):
+        handlers = [{"mouse-motion": 1 + i, "key-press": 3} for i in range(10)]
+        failures = growth.growth_failures(samples([5] * 10, handlers), TOLERANCES)
+        self.assertIn("handlers grew by 6", failures)
+        self.assertIn("mouse-motion handlers 3 -> 10", failures)
+        self.assertFalse(any("key-press" in failure for failure in failures))
+
+    def test_too_few_samples(self):
+        self.assertIsNone(growth.growth_failures(samples(list(range(6))), TOLERANCES))
+        self.assertIsNotNone(growth.growth_failures(samples(list(range(8))), TOLERANCES))
+
+
+if __name__ == "__main__":
+    unittest.main()
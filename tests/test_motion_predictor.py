@@ -0,0 +1,83 @@
+"""
+运动预测的测试
+
+Runs without Gtk: the predictor is loaded from its file by the replay
+benchmark.
+"""
+
+import unittest
+
+import os
+import tempfile
+
+from bench_motion_predictor import (
+    MotionPredictor,
+    load_trace,
+    motion_predictor,
+    replay,
+    replay_recorded,
+    true_trace,
+)
+
+
+class MotionPredictorTest(unittest.TestCase):
+    def test_prediction_reduces_replay_error(self):
+        trace = true_trace(seconds=10.0)
+        for lead_ms in (8, 16):
+            raw, predicted = replay(trace, lead_ms)
+            self.assertLess(predicted, raw / 2, f"{lead_ms}ms lead")
+
+    def feed_line(self, predictor) -> tuple[float, float]:
+        # 1000px/s 匀速向右，125Hz
+        out = (0.0, 0.0)
+        for index in range(20):
+            out = predictor.update(index * 8.0, 0.0, index * 0.008)
+        return out
+
+    def test_auto_lead_is_half_the_round_trip(self):
+        predictor = MotionPredictor(alpha=0.6, beta=0.2, latency_source=lambda: 20.0)
+        predictor.auto = True
+        x, _ = self.feed_line(predictor)
+        # 10ms 提前量，速度约 1000px/s
+        self.assertAlmostEqual(x - 19 * 8.0, 10.0, delta=2.0)
+
+    def test_auto_without_measurement_uses_fixed_lead(self):
+        predictor = MotionPredictor(alpha=0.6, beta=0.2, latency_source=lambda: None)
+        predictor.auto = True
+        self.assertEqual(self.feed_line(predictor), (19 * 8.0, 0.0))
+
+        predictor = MotionPredictor(lead_time=0.01, alpha=0.6, beta=0.2, latency_source=lambda: None)
+        predictor.auto = True
+        x, _ = self.feed_line(predictor)
+        self.assertAlmostEqual(x - 19 * 8.0, 10.0, delta=2.0)
+
+    def test_recorded_trace_round_trip(self):
+        # 录制 125Hz 采样，再按录制格式回放
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "trace.csv")
+            os.environ[motion_predictor.TRACE_ENV] = path
+            try:
+                recorder = MotionPredictor()
+                for t, x, y in true_trace(seconds=5.0)[::8]:
+                    recorder.update(x, y, t)
+            finally:
+                del os.environ[motion_predictor.TRACE_ENV]
+                if motion_predictor._trace_file is not None:
+                    motion_predictor._trace_file.close()
+                    motion_predictor._trace_file = None
+            trace = load_trace(path)
+        self.assertGreater(len(trace), 500)
+        raw, predicted = replay_recorded(trace, 16)
+        self.assertLess(predicted, raw / 2)
+
+    def test_auto_lead_is_capped(self):
+        predictor = MotionPredictor(
+            alpha=0.6, beta=0.2, max_lead_distance=1000.0, latency_source=lambda: 1000.0
+        )
+        predictor.auto = True
+        x, _ = self.feed_line(predictor)
+        self.assertLessEqual(x - 19 * 8.0, MotionPredictor.MAX_AUTO_LEAD * 1000 * 1.2)
+
+
+if __name__ == "__main__":
+    unittest.main()
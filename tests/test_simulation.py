@@ -0,0 +1,79 @@
+"""
+虚拟时间模拟的回归测试
+
+The controller modules import Gtk at module level, so the tests are
+skipped when PyGObject or a display is not available.
+"""
+
+import unittest
+
+try:
+    import gi
+
+    gi.require_version("Gtk", "4.0")
+    gi.require_version("Gdk", "4.0")
+    gi.require_version("Adw", "1")
+    from gi.repository import Gtk
+
+    HAS_DISPLAY = Gtk.init_check()
+except (ImportError, ValueError):
+    HAS_DISPLAY = False
+
+
+@unittest.skipUnless(HAS_DISPLAY, "needs PyGObject and a display")
+class TextCoalescingTest(unittest.TestCase):
+    """KeyboardDefault 的文本合并定时器走虚拟时钟"""
+
+    def run_typing(self) -> list[tuple[float, str]]:
+        from waydroid_helper.controller.core.control_msg import InjectTextMsg
+        from waydroid_helper.controller.core.event_bus import EventBus
+        from waydroid_helper.controller.core.handler.default.default_key_handler import (
+            KeyboardDefault,
+        )
+        from waydroid_helper.controller.core.simulation import Simulation
+
+        event_bus = EventBus()
+        keyboard = KeyboardDefault(event_bus)
+        with Simulation(event_bus) as sim:
+            sim.call(keyboard.queue_text, "a")
+            sim.advance_to(0.005)
+            sim.call(keyboard.queue_text, "b")
+            sim.call(keyboard.queue_text, "c")
+            sim.advance_to(0.1)
+            # 窗口已经关闭，下一段文本立即发送
+            sim.call(keyboard.queue_text, "d")
+            sim.advance_to(0.2)
+            self.assertEqual(sim.clock.pending, 0)
+            return [
+                (round(at, 6), msg.text)
+                for at, msg in sim.messages
+                if isinstance(msg, InjectTextMsg)
+            ]
+
+    def test_burst_is_merged_after_window(self):
+        from waydroid_helper.controller.core.handler.default.default_key_handler import (
+            KeyboardDefault,
+        )
+
+        window = KeyboardDefault.TEXT_COALESCE_MS / 1000
+        self.assertEqual(
+            self.run_typing(),
+            [(0.0, "a"), (round(window, 6), "bc"), (0.1, "d")],
+        )
+
+    def test_runs_are_deterministic(self):
+        self.assertEqual(self.run_typing(), self.run_typing())
+
+    def test_clock_is_restored(self):
+        from waydroid_helper.controller.core.clock import get_clock
+        from waydroid_helper.controller.core.event_bus import EventBus
+        from waydroid_helper.controller.core.simulation import Simulation
+
+        previous = get_clock()
+        with Simulation(EventBus()) as sim:
+            self.assertIs(get_clock(), sim.clock)
+        self.assertIs(get_clock(), previous)
+
+
+if __name__ == "__main__":
+    unittest.main()
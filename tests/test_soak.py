@@ -0,0 +1,66 @@
+"""
+长时间运行检查的测试
+
+A few virtual minutes of the built-in scenario must pass, and a run with
+a subscription leaked on every profile switch must fail.
+"""
+
+import unittest
+
+try:
+    import gi
+
+    gi.require_version("Gtk", "4.0")
+    gi.require_version("Gdk", "4.0")
+    gi.require_version("Adw", "1")
+    from gi.repository import Gtk
+
+    HAS_DISPLAY = Gtk.init_check()
+except (ImportError, ValueError):
+    HAS_DISPLAY = False
+
+
+class Leak:
+    """每次切换配置都留下一个订阅"""
+
+
+@unittest.skipUnless(HAS_DISPLAY, "needs PyGObject and a display")
+class SoakTestTest(unittest.TestCase):
+    def test_builtin_scenario_does_not_grow(self):
+        from waydroid_helper.controller.core.soak import run_soak
+
+        self.assertTrue(run_soak(0.05))
+
+    def test_leak_is_reported(self):
+        from waydroid_helper.controller.core.event_bus import EventBus, EventType
+        from waydroid_helper.controller.core.key_system import KeyRegistry
+        from waydroid_helper.controller.core.simulation import Simulation
+        from waydroid_helper.controller.core.soak import SoakTest, random_input_script
+
+        event_bus = EventBus()
+        leaked: list[Leak] = []
+
+        def leaky_switch(index: int) -> None:
+            subscriber = Leak()
+            leaked.append(subscriber)
+            event_bus.subscribe(EventType.MOUSE_MOTION, lambda event: None, subscriber=subscriber)
+
+        keys = [KeyRegistry().get_by_name("Q")]
+        try:
+            with Simulation(event_bus) as sim:
+                soak = SoakTest(
+                    sim,
+                    random_input_script(keys, (1920, 1080), presses_per_cycle=2),
+                    switch_profile=leaky_switch,
+                    sample_interval=20.0,
+                    profile_interval=10.0,
+                )
+                self.assertFalse(soak.run(300.0))
+                self.assertTrue(any("connections" in f for f in soak.failures))
+        finally:
+            for subscriber in leaked:
+                event_bus.unsubscribe_by_subscriber(subscriber)
+
+
+if __name__ == "__main__":
+    unittest.main()
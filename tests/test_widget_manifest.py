@@ -0,0 +1,56 @@
+"""
+组件清单的测试
+
+WIDGET_MANIFEST repeats each widget class's name and menu flag so the
+context menu can be built without importing the components; the entries
+must match the classes and list every component.
+"""
+
+import importlib
+import unittest
+
+try:
+    import gi
+
+    gi.require_version("Gtk", "4.0")
+    gi.require_version("Gdk", "4.0")
+    gi.require_version("Adw", "1")
+    from gi.repository import Gtk
+
+    HAS_DISPLAY = Gtk.init_check()
+except (ImportError, ValueError):
+    HAS_DISPLAY = False
+
+
+@unittest.skipUnless(HAS_DISPLAY, "needs PyGObject and a display")
+class WidgetManifestTest(unittest.TestCase):
+    def test_entries_match_classes(self):
+        from waydroid_helper.controller.widgets.factory import (
+            COMPONENTS_PACKAGE,
+            WIDGET_MANIFEST,
+        )
+
+        for widget_type, entry in WIDGET_MANIFEST.items():
+            with self.subTest(widget_type):
+                module = importlib.import_module(f"{COMPONENTS_PACKAGE}.{entry.module}")
+                widget_class = getattr(module, entry.class_name)
+                self.assertEqual(widget_class.__name__.lower(), widget_type)
+                self.assertEqual(widget_class.WIDGET_NAME, entry.name)
+                self.assertEqual(
+                    widget_class.ALLOW_CONTEXT_MENU_CREATION,
+                    entry.allow_context_menu_creation,
+                )
+
+    def test_lists_every_component(self):
+        from waydroid_helper.controller.widgets.factory import (
+            WIDGET_MANIFEST,
+            WidgetFactory,
+        )
+
+        factory = WidgetFactory()
+        factory.reload_widgets()
+        self.assertEqual(set(factory.widget_classes), set(WIDGET_MANIFEST))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -87,9 +87,12 @@ including Magisk, ARM translation, and various Google services alternatives.
 # D-Bus configuration
 %{_datadir}/dbus-1/system.d/id.waydro.Mount.conf
 %{_datadir}/dbus-1/system-services/id.waydro.Mount.service
+%{_datadir}/dbus-1/system.d/id.waydro.Helper.conf
+%{_datadir}/dbus-1/system-services/id.waydro.Helper.service
 
 # Systemd services
 %{_unitdir}/waydroid-mount.service
+%{_unitdir}/waydroid-privileged.service
 %{_userunitdir}/waydroid-monitor.service
 
 %changelog
@@ -1,7 +1,6 @@
 import asyncio
 from enum import IntEnum
-from functools import partial
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, cast
 
 import gi
 
@@ -10,7 +9,7 @@ gi.require_version("Adw", "1")
 
 from gettext import gettext as _
 
-from gi.repository import Adw, GObject, Gtk
+from gi.repository import Adw, Gio, GObject, Gtk
 
 from waydroid_helper.compat_widget import (HeaderBar, MessageDialog,
                                            NavigationPage, Spinner,
@@ -23,14 +22,20 @@ if TYPE_CHECKING:
 
 
 class AvailableRow(Adw.ActionRow):
+    """
+    Row widget recycled by the version list; bind() points it at a different
+    AvailableVersionItem whenever GtkListView scrolls it into view.
+    """
+
     class State(IntEnum):
         UNINSTALLED = 0
         INSTALLING = 1
         INSTALLED = 2
 
-    def __init__(self, name: str, version: str, installed: bool):
+    def __init__(self):
         super().__init__()
-        self.set_title(title=f"{name}-{version}")
+        self.item: AvailableVersionItem | None = None
+        self._state_handler_id: int | None = None
 
         button_size = 36
 
@@ -56,10 +61,28 @@ class AvailableRow(Adw.ActionRow):
         self.spinner.set_valign(align=Gtk.Align.CENTER)
         self.add_suffix(self.spinner)
 
-        if installed:
-            self.set_installation_state(self.State.INSTALLED)
-        else:
-            self.set_installation_state(self.State.UNINSTALLED)
+        self.set_installation_state(self.State.UNINSTALLED)
+
+    def bind(self, item: "AvailableVersionItem"):
+        self.unbind()
+        self.item = item
+        self.set_title(title=f"{item.name}-{item.version}")
+        self.set_validation_errors(
+            arch_error=item.arch_error,
+            android_version_error=item.android_version_error,
+        )
+        self.set_installation_state(self.State(item.state))
+        # Only bound rows listen, so state changes never touch off-screen items
+        self._state_handler_id = item.connect("notify::state", self._on_item_state_changed)
+
+    def unbind(self):
+        if self.item is not None and self._state_handler_id is not None:
+            self.item.disconnect(self._state_handler_id)
+        self.item = None
+        self._state_handler_id = None
+
+    def _on_item_state_changed(self, item: "AvailableVersionItem", param: GObject.ParamSpec):
+        self.set_installation_state(self.State(item.state))
 
     def set_installation_state(self, state: State):
         if state == self.State.INSTALLED:
@@ -102,6 +125,39 @@ class AvailableRow(Adw.ActionRow):
             self.delete_button.set_sensitive(True)
 
 
+class AvailableVersionItem(GObject.Object):
+    """
+    List model entry for one package version.
+
+    Validation results and the filter key are computed once when the catalog
+    is indexed, so binding a row does no package lookups.
+    """
+
+    state = GObject.Property(type=int, default=AvailableRow.State.UNINSTALLED)
+
+    def __init__(
+        self,
+        name: str,
+        version: str,
+        installed: bool,
+        arch_error: bool,
+        android_version_error: bool,
+    ):
+        super().__init__()
+        self.name: str = name
+        self.version: str = version
+        self.arch_error: bool = arch_error
+        self.android_version_error: bool = android_version_error
+        self.search_key: str = f"{name}-{version}".lower()
+        self.set_property(
+            "state",
+            AvailableRow.State.INSTALLED if installed else AvailableRow.State.UNINSTALLED,
+        )
+
+    def set_installation_state(self, state: AvailableRow.State):
+        self.set_property("state", int(state))
+
+
 # class CircularProgressBar(Gtk.DrawingArea):
 #     def __init__(self):
 #         super().__init__()
@@ -165,7 +221,6 @@ class AvailableVersionPage(NavigationPage):
     __gtype_name__: str = "AvailableVersionPage"
     extension_manager: PackageManager
     _task: Task = Task()
-    page: Adw.PreferencesPage
 
     # AdwLeafletView
     # if NAVIGATION_PAGE == "AdwLeafletPage":
@@ -176,77 +231,119 @@ class AvailableVersionPage(NavigationPage):
     ):
         super().__init__(title=_("Available Versions"))
         self.extension_manager = extension_manager
-        ext_versions = sorted(
-            ext_versions,
-            key=lambda x: x["version"],
-            reverse=True,
-        )
-        adw_preferences_group = Adw.PreferencesGroup.new()
-        self.page = Adw.PreferencesPage.new()
-        self.page.add(group=adw_preferences_group)
+
+        self.items: dict[str, AvailableVersionItem] = {}
+        self.lock: asyncio.Lock = asyncio.Lock()
+        self._filter_text: str = ""
+
+        # 预先排序并建立索引，列表只为可见行创建控件
+        self.store: Gio.ListStore = Gio.ListStore.new(AvailableVersionItem)
+        self.store.splice(0, 0, self._build_index(ext_versions))
+
+        self.version_filter: Gtk.CustomFilter = Gtk.CustomFilter.new(self._filter_func)
+        filter_model = Gtk.FilterListModel.new(self.store, self.version_filter)
+        selection_model = Gtk.NoSelection.new(filter_model)
+
+        factory = Gtk.SignalListItemFactory.new()
+        factory.connect("setup", self._on_factory_setup)
+        factory.connect("bind", self._on_factory_bind)
+        factory.connect("unbind", self._on_factory_unbind)
+
+        list_view = Gtk.ListView.new(selection_model, factory)
+
+        # ClampScrollable 把滚动交给 ListView，普通 Clamp 会让它按全部行分配高度，失去按需创建行的效果
+        clamp = Adw.ClampScrollable.new()
+        clamp.set_margin_start(12)
+        clamp.set_margin_end(12)
+        clamp.set_child(list_view)
+
+        scrolled_window = Gtk.ScrolledWindow.new()
+        scrolled_window.set_policy(Gtk.PolicyType.NEVER, Gtk.PolicyType.AUTOMATIC)
+        scrolled_window.set_vexpand(True)
+        scrolled_window.set_child(clamp)
+
+        search_entry = Gtk.SearchEntry.new()
+        search_entry.set_placeholder_text(_("Search versions"))
+        search_entry.connect("search-changed", self._on_search_changed)
 
         adw_header_bar = HeaderBar()
+        adw_header_bar.set_title_widget(search_entry)
         adw_tool_bar_view = ToolbarView.new()
         adw_tool_bar_view.add_top_bar(adw_header_bar)
 
-        adw_tool_bar_view.set_content(self.page)
+        adw_tool_bar_view.set_content(scrolled_window)
 
         self.set_child(adw_tool_bar_view)
 
-        self.rows: dict[str, AvailableRow] = {}
-        self.lock: asyncio.Lock = asyncio.Lock()
-
+    def _build_index(self, ext_versions: list["PackageInfo"]) -> list[AvailableVersionItem]:
+        ext_versions = sorted(
+            ext_versions,
+            key=lambda x: x["version"],
+            reverse=True,
+        )
+        items: list[AvailableVersionItem] = []
         for version in ext_versions:
-            installed = self.extension_manager.is_installed(
-                version["name"], version["version"]
-            )
-            adw_action_row = AvailableRow(
-                version["name"], version["version"], installed
+            name = version["name"]
+            ver = version["version"]
+            item = AvailableVersionItem(
+                name,
+                ver,
+                installed=self.extension_manager.is_installed(name, ver),
+                arch_error=not self.extension_manager.check_arch(
+                    name, ver, package_info=version
+                ).is_valid,
+                android_version_error=not self.extension_manager.check_android_version(
+                    name, ver, package_info=version
+                ).is_valid,
             )
-            
-            # Check validation errors
-            arch_validation = self.extension_manager.check_arch(version["name"], version["version"])
-            android_validation = self.extension_manager.check_android_version(version["name"], version["version"])
-            
-            # Set validation error labels and disable if needed
-            adw_action_row.set_validation_errors(
-                arch_error=not arch_validation.is_valid,
-                android_version_error=not android_validation.is_valid
-            )
-            
-            adw_action_row.delete_button.connect(
-                "clicked",
-                partial(
-                    self.on_delete_button_clicked,
-                    name=version["name"],
-                    version=version["version"],
-                ),
-            )
-            adw_action_row.install_button.connect(
-                "clicked",
-                partial(
-                    self.on_install_button_clicked,
-                    name=version["name"],
-                    version=version["version"],
-                ),
-            )
-            adw_preferences_group.add(child=adw_action_row)
-            self.rows[f"{version['name']}-{version['version']}"] = adw_action_row
+            self.items[f"{name}-{ver}"] = item
+            items.append(item)
+        return items
+
+    def _filter_func(self, item: AvailableVersionItem) -> bool:
+        return not self._filter_text or self._filter_text in item.search_key
+
+    def _on_search_changed(self, entry: Gtk.SearchEntry):
+        self._filter_text = entry.get_text().strip().lower()
+        self.version_filter.changed(Gtk.FilterChange.DIFFERENT)
+
+    def _on_factory_setup(self, factory: Gtk.SignalListItemFactory, list_item: Gtk.ListItem):
+        row = AvailableRow()
+        row.delete_button.connect("clicked", self._on_row_delete_clicked, row)
+        row.install_button.connect("clicked", self._on_row_install_clicked, row)
+        list_item.set_child(row)
+
+    def _on_factory_bind(self, factory: Gtk.SignalListItemFactory, list_item: Gtk.ListItem):
+        row = cast(AvailableRow, list_item.get_child())
+        row.bind(cast(AvailableVersionItem, list_item.get_item()))
+
+    def _on_factory_unbind(self, factory: Gtk.SignalListItemFactory, list_item: Gtk.ListItem):
+        row = cast(AvailableRow, list_item.get_child())
+        row.unbind()
+
+    def _on_row_install_clicked(self, button: Gtk.Button, row: AvailableRow):
+        if row.item is not None:
+            self.on_install_button_clicked(button, name=row.item.name, version=row.item.version)
+
+    def _on_row_delete_clicked(self, button: Gtk.Button, row: AvailableRow):
+        if row.item is not None:
+            self.on_delete_button_clicked(button, name=row.item.name, version=row.item.version)
+
+    def _set_item_state(self, name: str, version: str, state: AvailableRow.State):
+        item = self.items.get(f"{name}-{version}")
+        if item is not None:
+            item.set_installation_state(state)
 
     def on_installation_started(
         self, obj: GObject.Object, name: str, version: str
     ) -> None:
         pass
-        # self.rows[f"{name}-{version}"].set_installation_state(
-        #     AvailableRow.State.INSTALLING
-        # )
+        # self._set_item_state(name, version, AvailableRow.State.INSTALLING)
 
     def on_installation_completed(
         self, obj: GObject.Object, name: str, version: str
     ) -> None:
-        self.rows[f"{name}-{version}"].set_installation_state(
-            AvailableRow.State.INSTALLED
-        )
+        self._set_item_state(name, version, AvailableRow.State.INSTALLED)
         dialog = MessageDialog(
             _("Installation Complete"),
             _("{0} has been successfully installed.").format(f"{name}-{version}"),
@@ -264,9 +361,7 @@ class AvailableVersionPage(NavigationPage):
     def on_uninstallation_completed(
         self, obj: GObject.Object, name: str, version: str
     ) -> None:
-        self.rows[f"{name}-{version}"].set_installation_state(
-            AvailableRow.State.UNINSTALLED
-        )
+        self._set_item_state(name, version, AvailableRow.State.UNINSTALLED)
         dialog = MessageDialog(
             _("Uninstallation Complete"),
             _("{0} has been successfully uninstalled.").format(f"{name}-{version}"),
@@ -322,9 +417,7 @@ class AvailableVersionPage(NavigationPage):
         installation_successful = False
         try:
             # Spinner
-            self.rows[f"{name}-{version}"].set_installation_state(
-                AvailableRow.State.INSTALLING
-            )
+            self._set_item_state(name, version, AvailableRow.State.INSTALLING)
             async with self.lock:
                 arch_check = self.extension_manager.check_arch(name, version)
                 if not await self.show_validation_error(arch_check):
@@ -364,16 +457,12 @@ class AvailableVersionPage(NavigationPage):
             dialog.present()
         finally:
             if not installation_successful:
-                self.rows[f"{name}-{version}"].set_installation_state(
-                    AvailableRow.State.UNINSTALLED
-                )
+                self._set_item_state(name, version, AvailableRow.State.UNINSTALLED)
 
     async def __uninstall(self, name:str, version:str):
         uninstall_successful = False
         try:
-            self.rows[f"{name}-{version}"].set_installation_state(
-                AvailableRow.State.INSTALLING
-            )
+            self._set_item_state(name, version, AvailableRow.State.INSTALLING)
             if await self.show_dialog(
                 _("Uninstall Confirmation"),
                 _("Do you want to uninstall") + " " + name,
@@ -381,9 +470,7 @@ class AvailableVersionPage(NavigationPage):
                 await self.extension_manager.remove_package(name)
                 uninstall_successful = True
         except Exception as e:
-            self.rows[f"{name}-{version}"].set_installation_state(
-                AvailableRow.State.INSTALLED
-            )
+            self._set_item_state(name, version, AvailableRow.State.INSTALLED)
             logger.error(e)
             dialog = MessageDialog(
                 heading=_("Uninstallation Failed"), body=str(e), parent=self.get_root()
@@ -392,9 +479,7 @@ class AvailableVersionPage(NavigationPage):
             dialog.present()
         finally:
             if not uninstall_successful:
-                self.rows[f"{name}-{version}"].set_installation_state(
-                    AvailableRow.State.INSTALLED
-                )
+                self._set_item_state(name, version, AvailableRow.State.INSTALLED)
 
     def on_install_button_clicked(self, button: Gtk.Button, name:str, version:str):
         self._task.create_task(self.__install(name, version))
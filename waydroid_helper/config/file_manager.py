@@ -1,13 +1,227 @@
+import atexit
+import copy
 import json
+import os
+import tempfile
 from pathlib import Path
-from typing import Any
-from gi.repository import GLib
+from typing import Any, Callable
+from gi.repository import Gio, GLib
 
 from waydroid_helper.util.log import logger
 
 
+class ConfigStore:
+    """
+    进程内共享的配置缓存
+
+    The file is parsed once per process; reads are served from memory and
+    writes are coalesced into one atomic replace after WRITE_DELAY_MS. The
+    file is watched so edits from another process (e.g. the key mapper)
+    are picked up without polling. If that happens while a write is still
+    pending, the changes made here since the last write are re-applied on
+    top of the file's new content, so neither side is lost.
+
+    A failed delayed write is logged and kept as write_failed; the changes
+    stay in memory and are written with the next change or flush().
+    """
+
+    WRITE_DELAY_MS = 200
+
+    _stores: dict[Path, "ConfigStore"] = {}
+
+    @classmethod
+    def for_file(cls, config_file: Path) -> "ConfigStore":
+        store = cls._stores.get(config_file)
+        if store is None:
+            store = cls(config_file)
+            cls._stores[config_file] = store
+        return store
+
+    @classmethod
+    def flush_all(cls) -> None:
+        for store in cls._stores.values():
+            if store.has_pending_write() or store.write_failed:
+                store.flush()
+
+    def __init__(self, config_file: Path):
+        self.config_file: Path = config_file
+        self.data: dict[str, Any] = {}
+        self._loaded: bool = False
+        self._write_source_id: int | None = None
+        # 最近一次写回是否失败；失败的修改仍在内存中，等待下一次写回
+        self.write_failed: bool = False
+        self._monitor: Gio.FileMonitor | None = None
+        # 最近一次由本进程写出的内容，用于忽略自身写入触发的文件事件
+        self._last_written: str | None = None
+        # 上次写出之后本进程做的修改，外部修改到来时重新应用
+        self._pending_changes: list[Callable[[dict[str, Any]], Any]] = []
+
+    def ensure_loaded(self) -> dict[str, Any]:
+        if not self._loaded:
+            self._loaded = True
+            self.data = self._read()
+            self._start_monitor()
+        return self.data
+
+    def _parse(self, content: str) -> dict[str, Any] | None:
+        try:
+            config = json.loads(content)
+        except json.JSONDecodeError as e:
+            logger.error(f"Config file JSON format error: {e}")
+            return None
+        return config if isinstance(config, dict) else None
+
+    def _read(self) -> dict[str, Any]:
+        if not self.config_file.exists():
+            logger.info(f"Config file not found: {self.config_file}")
+            return {}
+
+        try:
+            with open(self.config_file, 'r', encoding='utf-8') as f:
+                config = json.load(f)
+                logger.debug(f"Loaded config file: {self.config_file}")
+                return config if isinstance(config, dict) else {}
+        except json.JSONDecodeError as e:
+            logger.error(f"Config file JSON format error: {e}")
+            return {}
+        except Exception as e:
+            logger.error(f"Failed to load config file: {e}")
+            return {}
+
+    def reload(self) -> None:
+        """丢弃内存中的数据并重新读取文件"""
+        self._cancel_pending_write()
+        self._pending_changes.clear()
+        self.write_failed = False
+        self._loaded = True
+        self.data = self._read()
+
+    def has_pending_write(self) -> bool:
+        return self._write_source_id is not None
+
+    def record_change(self, change: Callable[[dict[str, Any]], Any]) -> None:
+        """对 data 应用一次修改并在 WRITE_DELAY_MS 后写回"""
+        change(self.ensure_loaded())
+        self._pending_changes.append(change)
+        self.schedule_write()
+
+    def schedule_write(self) -> None:
+        """在 WRITE_DELAY_MS 后写回文件，期间的多次修改只写一次"""
+        if self._write_source_id is None:
+            self._write_source_id = GLib.timeout_add(
+                self.WRITE_DELAY_MS, self._on_write_timeout
+            )
+
+    def _on_write_timeout(self) -> bool:
+        self._write_source_id = None
+        self._write()
+        return False
+
+    def _cancel_pending_write(self) -> None:
+        if self._write_source_id is not None:
+            GLib.source_remove(self._write_source_id)
+            self._write_source_id = None
+
+    def flush(self) -> bool:
+        """立即写回文件"""
+        self._cancel_pending_write()
+        return self._write()
+
+    def _write(self) -> bool:
+        self.write_failed = not self._write_file()
+        return not self.write_failed
+
+    def _write_file(self) -> bool:
+        config_dir = self.config_file.parent
+        try:
+            config_dir.mkdir(parents=True, exist_ok=True)
+        except Exception as e:
+            logger.error(f"Failed to create config directory {config_dir}: {e}")
+            return False
+
+        content = json.dumps(self.data, indent=2, ensure_ascii=False)
+        tmp_path: str | None = None
+        try:
+            # 写入同目录的临时文件后 rename，读者不会看到写了一半的文件
+            fd, tmp_path = tempfile.mkstemp(
+                prefix=f".{self.config_file.name}.", dir=config_dir
+            )
+            with os.fdopen(fd, 'w', encoding='utf-8') as f:
+                f.write(content)
+                f.flush()
+                os.fsync(f.fileno())
+            os.replace(tmp_path, self.config_file)
+            self._last_written = content
+            self._pending_changes.clear()
+            logger.debug(f"Saved config file: {self.config_file}")
+            return True
+        except Exception as e:
+            logger.error(f"Failed to save config file: {e}")
+            if tmp_path is not None and os.path.exists(tmp_path):
+                os.unlink(tmp_path)
+            return False
+
+    def _start_monitor(self) -> None:
+        try:
+            gfile = Gio.File.new_for_path(str(self.config_file))
+            self._monitor = gfile.monitor_file(Gio.FileMonitorFlags.WATCH_MOVES, None)
+            self._monitor.connect("changed", self._on_file_changed)
+        except GLib.Error as e:
+            logger.warning(f"Cannot watch config file {self.config_file}: {e}")
+            self._monitor = None
+
+    def _on_file_changed(
+        self,
+        _monitor: Gio.FileMonitor,
+        _file: Gio.File,
+        _other_file: Gio.File | None,
+        event_type: Gio.FileMonitorEvent,
+    ) -> None:
+        if event_type not in (
+            Gio.FileMonitorEvent.CHANGES_DONE_HINT,
+            Gio.FileMonitorEvent.CREATED,
+            Gio.FileMonitorEvent.MOVED_IN,
+            Gio.FileMonitorEvent.RENAMED,
+            Gio.FileMonitorEvent.DELETED,
+        ):
+            return
+
+        try:
+            content = self.config_file.read_text(encoding='utf-8')
+        except OSError:
+            content = None
+        if content is not None and content == self._last_written:
+            return
+
+        if self.has_pending_write():
+            # 本进程还有未写出的修改：以文件的新内容为基础重新应用这些修改
+            external = self._parse(content) if content is not None else None
+            if external is None:
+                logger.warning(
+                    f"Config file {self.config_file} changed externally but cannot be "
+                    "read; keeping local changes"
+                )
+                return
+            logger.info(
+                f"Config file {self.config_file} changed externally while local "
+                "changes are pending; merging"
+            )
+            self.data = external
+            for change in self._pending_changes:
+                change(self.data)
+            return
+
+        logger.debug(f"Config file changed externally, reloading: {self.config_file}")
+        self.data = self._read()
+
+
+atexit.register(ConfigStore.flush_all)
+
+_MISSING = object()
+
+
 class ConfigManager:
-    """配置管理器 - 无状态的文件读写类"""
+    """配置管理器 - 共享 ConfigStore 的文件读写接口"""
     
     DEFAULT_CONFIG_DIR = Path(GLib.get_user_config_dir()) / "waydroid-helper"
     DEFAULT_CONFIG_FILE = "config.json"
@@ -21,42 +235,20 @@ class ConfigManager:
         """
         self.config_dir = config_dir or self.DEFAULT_CONFIG_DIR
         self.config_file = self.config_dir / self.DEFAULT_CONFIG_FILE
-        
-    def _ensure_config_dir(self) -> bool:
-        """确保配置目录存在"""
-        try:
-            self.config_dir.mkdir(parents=True, exist_ok=True)
-            return True
-        except Exception as e:
-            logger.error(f"Failed to create config directory {self.config_dir}: {e}")
-            return False
+        self._store = ConfigStore.for_file(self.config_file)
     
     def load_config(self) -> dict[str, Any]:
         """
-        从文件加载配置
+        获取配置副本
         
         Returns:
             配置字典，如果文件不存在或读取失败则返回空字典
         """
-        if not self.config_file.exists():
-            logger.info(f"Config file not found: {self.config_file}")
-            return {}
-        
-        try:
-            with open(self.config_file, 'r', encoding='utf-8') as f:
-                config = json.load(f)
-                logger.debug(f"Loaded config file: {self.config_file}")
-                return config
-        except json.JSONDecodeError as e:
-            logger.error(f"Config file JSON format error: {e}")
-            return {}
-        except Exception as e:
-            logger.error(f"Failed to load config file: {e}")
-            return {}
+        return copy.deepcopy(self._store.ensure_loaded())
     
     def save_config(self, config: dict[str, Any]) -> bool:
         """
-        将配置保存到文件
+        替换整个配置并立即保存到文件
         
         Args:
             config: 要保存的配置字典
@@ -64,17 +256,21 @@ class ConfigManager:
         Returns:
             保存是否成功
         """
-        if not self._ensure_config_dir():
-            return False
-        
-        try:
-            with open(self.config_file, 'w', encoding='utf-8') as f:
-                json.dump(config, f, indent=2, ensure_ascii=False)
-                logger.debug(f"Saved config file: {self.config_file}")
-                return True
-        except Exception as e:
-            logger.error(f"Failed to save config file: {e}")
-            return False
+        self._store.ensure_loaded()
+        self._store.data = copy.deepcopy(config)
+        return self._store.flush()
+    
+    def flush(self) -> bool:
+        """
+        立即写出尚未保存的修改
+
+        Returns:
+            False if the write fails, including a retry of an earlier
+            delayed write that failed
+        """
+        if not self._store.has_pending_write() and not self._store.write_failed:
+            return True
+        return self._store.flush()
     
     def get_value(self, key: str, default: Any | None = None) -> Any:
         """
@@ -85,40 +281,45 @@ class ConfigManager:
             default: 默认值
             
         Returns:
-            配置值或默认值
+            配置值或默认值；dict/list 返回副本，修改它不会影响缓存
         """
-        config = self.load_config()
-        return self._get_nested_value(config, key, default)
+        value = self._get_nested_value(self._store.ensure_loaded(), key, default)
+        if isinstance(value, (dict, list)):
+            return copy.deepcopy(value)
+        return value
     
     def set_value(self, key: str, value: Any) -> bool: # pyright: ignore[reportUnknownParameterType]
         """
-        设置配置值
+        设置配置值，稍后写回文件
         
         Args:
             key: 配置键，支持点分隔的嵌套键，如 "cage.enabled"
             value: 配置值
             
         Returns:
-            设置是否成功
+            True: the value is set in memory and will be written within
+            WRITE_DELAY_MS; it is not persisted yet. Call flush() to write
+            now and find out whether saving succeeded.
         """
-        config = self.load_config()
-        self._set_nested_value(config, key, value)
-        return self.save_config(config)
+        value = copy.deepcopy(value)
+        self._store.record_change(lambda config: self._set_nested_value(config, key, value))
+        return True
     
     def delete_value(self, key: str) -> bool:
         """
-        删除配置值
+        删除配置值，稍后写回文件
         
         Args:
             key: 配置键，支持点分隔的嵌套键
             
         Returns:
-            删除是否成功
+            False if the key does not exist; True means removed in memory,
+            not yet persisted, as with set_value()
         """
-        config = self.load_config()
-        if self._delete_nested_value(config, key):
-            return self.save_config(config)
-        return False
+        if self._get_nested_value(self._store.ensure_loaded(), key, _MISSING) is _MISSING:
+            return False
+        self._store.record_change(lambda config: self._delete_nested_value(config, key))
+        return True
     
     def _get_nested_value(self, config: dict[str, Any], key: str, default: Any | None = None) -> Any:
         """获取嵌套配置值"""
@@ -176,6 +377,7 @@ class ConfigManager:
         Returns:
             备份是否成功
         """
+        self.flush()
         if not self.config_file.exists():
             logger.warning("Config file not found, cannot backup")
             return False
@@ -210,6 +412,7 @@ class ConfigManager:
         try:
             import shutil
             shutil.copy2(backup_file, self.config_file)
+            self._store.reload()
             logger.info(f"Config file restored from backup: {backup_file}")
             return True
         except Exception as e:
@@ -12,6 +12,7 @@ from functools import partial
 
 import gi, signal
 
+from waydroid_helper.controller.core.clipboard_sync import ClipboardSync
 from waydroid_helper.controller.core.control_msg import ScreenInfo
 from waydroid_helper.controller.core.utils import PointerIdManager
 
@@ -29,6 +30,9 @@ from waydroid_helper.controller.app.workspace_manager import WorkspaceManager
 from waydroid_helper.controller.core import (Event, EventType, KeyCombination,
                                              Server, EventBus,
                                              is_point_in_rect, KeyRegistry)
+from waydroid_helper.controller.core.key_system import KeycodeTable
+from waydroid_helper.controller.core.latency_probe import LatencyProbe
+from waydroid_helper.controller.core.rate_controller import OutputRateController
 from waydroid_helper.controller.core.constants import APP_TITLE
 from waydroid_helper.controller.core.handler import (DefaultEventHandler,
                                                      InputEvent,
@@ -39,6 +43,8 @@ from waydroid_helper.controller.ui.menus import ContextMenuManager
 from waydroid_helper.controller.ui.styles import StyleManager
 from waydroid_helper.controller.widgets.factory import WidgetFactory
 from waydroid_helper.util import AdbHelper, logger
+from waydroid_helper.util.idle import IdleMonitor
+from waydroid_helper.util.task import TaskSupervisor
 
 if TYPE_CHECKING:
     from waydroid_helper.controller.widgets.base import BaseWidget
@@ -785,14 +791,26 @@ class TransparentWindow(Adw.Window):
 
         self.pointer_id_manager = PointerIdManager()
         self.key_registry = KeyRegistry()
+        # 键码 -> 按键，按键映射只查表，不再逐次调用 translate_key
+        self.keycode_table = KeycodeTable(self.key_registry, self.get_display())
         self.menu_manager.reload_profile_hotkey()
         self.key_mapping_manager = KeyMappingManager(self.event_bus)
         # Create global event handler chain
         self.event_handler_chain = InputEventHandlerChain()
         # Import and add default handler
         self.server = Server("0.0.0.0", 10721, self.event_bus)  # 使用单例模式
+        self.clipboard_sync = ClipboardSync(self.event_bus, self.get_clipboard())
+        self.clipboard_sync.start()
+        self.latency_probe = LatencyProbe(self.event_bus, lambda: self.server.connected)
+        self.clipboard_sync.latency_probe = self.latency_probe
+        self.latency_probe.start()
+        self.output_rate = OutputRateController(lambda: self.server.queue_depth, self.latency_probe)
+        self.output_rate.start()
         self.adb_helper = AdbHelper()
-        self.scrcpy_setup_task = asyncio.create_task(self.setup_scrcpy())
+        self.tasks = TaskSupervisor().scope("TransparentWindow", owner=self)
+        self.scrcpy_setup_task = self.tasks.create_task(self.setup_scrcpy(), name="scrcpy-setup")
+        # 一段时间没有输入后进入空闲模式，停掉各组件的轮询
+        IdleMonitor().start()
         self.key_mapping_handler = KeyMappingEventHandler(self.key_mapping_manager)
         self.default_handler = DefaultEventHandler(self.event_bus)
 
@@ -971,7 +989,7 @@ class TransparentWindow(Adw.Window):
 
                 popover.connect(
                     "closed",
-                    lambda w: asyncio.create_task(on_popover_closed_with_mask(w)),
+                    lambda w: self.tasks.create_task(on_popover_closed_with_mask(w)),
                 )
         else:
             # 原有的 autohide 为 true 的逻辑
@@ -1241,10 +1259,19 @@ class TransparentWindow(Adw.Window):
         self.active_mask_layer.set_opacity(0.0)
 
     def _on_close_request(self, window):
+        self.clipboard_sync.stop()
+        self.latency_probe.stop()
+        self.output_rate.stop()
+        self.keycode_table.detach()
+
         async def close():
             await self.close_server()
             await self.cleanup_scrcpy()
-        asyncio.create_task(close())
+            self.tasks.close()
+            if logger.isEnabledFor(10):
+                TaskSupervisor().log_report()
+        # 关闭流程比窗口活得久，放到根作用域
+        TaskSupervisor().root.create_task(close())
         return False
 
     # def close(self):
@@ -1376,10 +1403,12 @@ class TransparentWindow(Adw.Window):
         # Window-level mouse scroll events
         scroll_controller = Gtk.EventControllerScroll.new(
             flags=Gtk.EventControllerScrollFlags.BOTH_AXES
+            | Gtk.EventControllerScrollFlags.KINETIC
         )
         scroll_controller.connect("scroll-begin", self.on_window_mouse_scroll)
         scroll_controller.connect("scroll", self.on_window_mouse_scroll)
         scroll_controller.connect("scroll-end", self.on_window_mouse_scroll)
+        scroll_controller.connect("decelerate", self.on_window_mouse_scroll_decelerate)
         self.add_controller(scroll_controller)
 
         # Window-level mouse event controller
@@ -1518,6 +1547,16 @@ class TransparentWindow(Adw.Window):
             )
             self.event_handler_chain.process_event(event)
 
+    def on_window_mouse_scroll_decelerate(
+        self, controller: Gtk.EventControllerScroll, vel_x: float, vel_y: float
+    ):
+        if self.current_mode == self.MAPPING_MODE:
+            event = InputEvent(
+                event_type="mouse_scroll_decelerate",
+                raw_data={"controller": controller, "vel_x": vel_x, "vel_y": vel_y},
+            )
+            self.event_handler_chain.process_event(event)
+
     def on_window_mouse_zoom(self, controller, zoom, status:str):
         event = InputEvent(
             event_type="mouse_zoom",
@@ -1860,6 +1899,10 @@ class TransparentWindow(Adw.Window):
 
     def get_physical_keyval(self, keycode):
         """Gets the standard keyval for the physical key (independent of modifier keys)"""
+        keyval = self.keycode_table.keyval(keycode)
+        if keyval:
+            return keyval
+        # 超出查找表范围的键码
         try:
             display = self.get_display()
             if display:
@@ -1872,6 +1915,18 @@ class TransparentWindow(Adw.Window):
             logger.error(f"Failed to get physical keyval: {e}")
         return 0
 
+    def resolve_key(self, keyval, keycode):
+        """Resolves the mapping key for a key event through the keycode table"""
+        # Modifier keys are resolved by their own keyval
+        if self._is_modifier_key(keyval):
+            return self.key_registry.create_from_keyval(keyval)
+        key = self.keycode_table.lookup(keycode)
+        if key is not None:
+            return key
+        # If the keycode is unknown, fallback to original keyval
+        physical_keyval = self.get_physical_keyval(keycode) or keyval
+        return self.key_registry.create_from_keyval(physical_keyval)
+
     def on_global_key_press(self, controller, keyval, keycode, state):
         """Global keyboard event - supports dual mode, uses event handler chain"""
         if self.right_click_overlay.handle_tuning_key(keyval, state):
@@ -1898,6 +1953,16 @@ class TransparentWindow(Adw.Window):
         ):
             return True
 
+        # Ctrl+Shift+V pastes the host clipboard on the device
+        if (
+            self.current_mode == self.MAPPING_MODE
+            and Gdk.keyval_to_lower(keyval) == Gdk.KEY_v
+            and state & Gdk.ModifierType.CONTROL_MASK
+            and state & Gdk.ModifierType.SHIFT_MASK
+        ):
+            self.clipboard_sync.paste_host_clipboard()
+            return True
+
         # Special keys: mode switching and debug functions - these are directly judged by original keyval
         if keyval == Gdk.KEY_F1:
             # F1 switches between two modes
@@ -1921,17 +1986,8 @@ class TransparentWindow(Adw.Window):
         # Use event handler chain in mapping mode
         if self.current_mode == self.MAPPING_MODE:
 
-            # Get standard keyval for physical key
-            physical_keyval = self.get_physical_keyval(keycode)
-            if physical_keyval == 0:
-                # If failed to get, fallback to original keyval
-                physical_keyval = keyval
-
-            # Process modifier keys themselves
-            if self._is_modifier_key(keyval):
-                main_key = self.key_registry.create_from_keyval(keyval)
-            else:
-                main_key = self.key_registry.create_from_keyval(physical_keyval)
+            # Get the key bound to the physical key
+            main_key = self.resolve_key(keyval, keycode)
 
             if main_key:
                 # Collect modifier keys
@@ -2075,6 +2131,7 @@ class TransparentWindow(Adw.Window):
         if self.current_mode == new_mode:
             return True
 
+        IdleMonitor().notify_activity("mode")
 
         # Use property system to set mode, which will trigger _on_mode_changed callback
         self.set_property("current-mode", new_mode)
@@ -2145,17 +2202,8 @@ class TransparentWindow(Adw.Window):
     def on_global_key_release(self, controller, keyval, keycode, state):
         """Global key release event - uses event handler chain"""
         if self.current_mode == self.MAPPING_MODE:
-            # Get standard keyval for physical key
-            physical_keyval = self.get_physical_keyval(keycode)
-            if physical_keyval == 0:
-                # If failed to get, fallback to original keyval
-                physical_keyval = keyval
-
-            # Process modifier keys themselves
-            if self._is_modifier_key(keyval):
-                main_key = self.key_registry.create_from_keyval(keyval)
-            else:
-                main_key = self.key_registry.create_from_keyval(physical_keyval)
+            # Get the key bound to the physical key
+            main_key = self.resolve_key(keyval, keycode)
 
             if main_key:
                 # Collect modifier keys
@@ -2269,7 +2317,7 @@ class KeyMapper(Adw.Application):
 
     def on_sigterm(self):
         # 只调度异步任务，不要直接退出
-        asyncio.create_task(self._do_shutdown())
+        TaskSupervisor().root.create_task(self._do_shutdown())
         return True
 
 def create_keymapper(display_name: str, host_display_name: str | None = None):
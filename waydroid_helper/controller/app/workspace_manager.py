@@ -33,8 +33,14 @@ class WorkspaceManager:
         self.interaction_start_x = 0
         self.interaction_start_y = 0
         self.pending_resize_direction = None
-        self.event_bus.subscribe(EventType.CREATE_WIDGET, lambda event: self.window.create_widget_at_position(event.data['widget'], event.data['x'], event.data['y']), subscriber=self)
-        self.event_bus.subscribe(EventType.DELETE_WIDGET, lambda event: self.delete_specific_widget(event.data), subscriber=self)
+        self.event_bus.subscribe(EventType.CREATE_WIDGET, self._on_create_widget, subscriber=self)
+        self.event_bus.subscribe(EventType.DELETE_WIDGET, self._on_delete_widget, subscriber=self)
+
+    def _on_create_widget(self, event):
+        self.window.create_widget_at_position(event.data['widget'], event.data['x'], event.data['y'])
+
+    def _on_delete_widget(self, event):
+        self.delete_specific_widget(event.data)
 
     def handle_mouse_press(self, controller, n_press, x, y):
         """处理鼠标按下事件"""
@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+"""
+剪贴板同步
+在主机剪贴板和 Android 剪贴板之间双向同步文本
+"""
+
+import hashlib
+from typing import TYPE_CHECKING, Any
+
+import gi
+
+gi.require_version("Gdk", "4.0")
+from gi.repository import Gdk, Gio, GLib
+
+from waydroid_helper.config.file_manager import ConfigManager as FileConfigManager
+from waydroid_helper.controller.core.control_msg import (
+    CLIPBOARD_TEXT_MAX_LENGTH,
+    SetClipboardMsg,
+)
+from waydroid_helper.controller.core.device_msg import (
+    AckClipboardDeviceMsg,
+    ClipboardDeviceMsg,
+)
+from waydroid_helper.controller.core.event_bus import Event, EventBus, EventType
+from waydroid_helper.util.log import logger
+
+if TYPE_CHECKING:
+    from waydroid_helper.controller.core.latency_probe import LatencyProbe
+
+TEXT_MIME_TYPES = ["text/plain;charset=utf-8", "text/plain"]
+
+
+class ClipboardSync:
+    """
+    剪贴板双向同步
+
+    Host changes come from the Gdk.Clipboard "changed" signal and are sent
+    with SET_CLIPBOARD; device changes arrive as CLIPBOARD device messages,
+    which the server (running with clipboard_autosync=false) only sends in
+    reply to LatencyProbe's periodic GET_CLIPBOARD.
+    Both sides are compared by content hash against the last synced value,
+    which stops echo loops and skips resending identical (possibly large)
+    text. Host content is read as a stream in READ_CHUNK_SIZE pieces and
+    given up on as soon as it exceeds the scrcpy message limit, so a huge
+    clipboard is never loaded in full.
+
+    paste_host_clipboard() sends the host text with paste set, so the
+    device pastes it into the focused field in one step; the device
+    reporting that text back is suppressed by the same hash check.
+    """
+
+    ENABLED_CONFIG_KEY = "controller.clipboard_sync"
+    READ_CHUNK_SIZE = 64 * 1024
+
+    def __init__(self, event_bus: EventBus, clipboard: Gdk.Clipboard):
+        self.event_bus = event_bus
+        self.clipboard = clipboard
+        self.max_length = CLIPBOARD_TEXT_MAX_LENGTH
+        self._last_hash: bytes | None = None
+        self._sequence = 0
+        self._cancellable: Gio.Cancellable | None = None
+        self._changed_handler_id: int | None = None
+        # 用带序号的 SET_CLIPBOARD 和对应的 ACK 测量往返延迟
+        self.latency_probe: "LatencyProbe | None" = None
+        self.enabled = bool(
+            FileConfigManager().get_value(self.ENABLED_CONFIG_KEY, True)
+        )
+
+    def start(self) -> None:
+        if not self.enabled or self._changed_handler_id is not None:
+            return
+        self._changed_handler_id = self.clipboard.connect("changed", self._on_host_changed)
+        self.event_bus.subscribe(EventType.DEVICE_MSG, self._on_device_msg, subscriber=self)
+
+    def stop(self) -> None:
+        if self._changed_handler_id is not None:
+            self.clipboard.disconnect(self._changed_handler_id)
+            self._changed_handler_id = None
+        self._cancel_read()
+        self.event_bus.unsubscribe_by_subscriber(self)
+
+    @staticmethod
+    def _hash(data: bytes) -> bytes:
+        return hashlib.blake2b(data, digest_size=16).digest()
+
+    def _cancel_read(self) -> None:
+        if self._cancellable is not None:
+            self._cancellable.cancel()
+            self._cancellable = None
+
+    # 主机 -> 设备
+
+    def _on_host_changed(self, clipboard: Gdk.Clipboard) -> None:
+        # 自己设置的内容（来自设备）不需要再发回去
+        if clipboard.is_local():
+            return
+        self._read_host(paste=False)
+
+    def paste_host_clipboard(self) -> bool:
+        """
+        把主机剪贴板的文本粘贴到设备当前的输入框
+
+        Returns False when the host clipboard holds no text.
+        """
+        return self._read_host(paste=True)
+
+    def _read_host(self, paste: bool) -> bool:
+        formats = self.clipboard.get_formats()
+        if not any(formats.contain_mime_type(mime) for mime in TEXT_MIME_TYPES):
+            return False
+
+        self._cancel_read()
+        cancellable = Gio.Cancellable()
+        self._cancellable = cancellable
+        self.clipboard.read_async(
+            TEXT_MIME_TYPES,
+            GLib.PRIORITY_DEFAULT,
+            cancellable,
+            self._on_read_ready,
+            (cancellable, paste),
+        )
+        return True
+
+    def _on_read_ready(
+        self,
+        clipboard: Gdk.Clipboard,
+        result: Gio.AsyncResult,
+        user_data: tuple[Gio.Cancellable, bool],
+    ) -> None:
+        cancellable, paste = user_data
+        try:
+            stream, _mime_type = clipboard.read_finish(result)
+        except GLib.Error as e:
+            if not e.matches(Gio.io_error_quark(), Gio.IOErrorEnum.CANCELLED):
+                logger.debug(f"Failed to read host clipboard: {e}")
+            return
+        if stream is None:
+            return
+        self._read_chunk(stream, bytearray(), cancellable, paste)
+
+    def _read_chunk(
+        self,
+        stream: Gio.InputStream,
+        buffer: bytearray,
+        cancellable: Gio.Cancellable,
+        paste: bool,
+    ) -> None:
+        stream.read_bytes_async(
+            self.READ_CHUNK_SIZE,
+            GLib.PRIORITY_DEFAULT,
+            cancellable,
+            self._on_chunk_ready,
+            (buffer, cancellable, paste),
+        )
+
+    def _on_chunk_ready(
+        self,
+        stream: Gio.InputStream,
+        result: Gio.AsyncResult,
+        user_data: tuple[bytearray, Gio.Cancellable, bool],
+    ) -> None:
+        buffer, cancellable, paste = user_data
+        try:
+            chunk = stream.read_bytes_finish(result)
+        except GLib.Error as e:
+            if not e.matches(Gio.io_error_quark(), Gio.IOErrorEnum.CANCELLED):
+                logger.debug(f"Failed to read host clipboard: {e}")
+            stream.close_async(GLib.PRIORITY_DEFAULT, None, None)
+            return
+
+        data = chunk.get_data() or b""
+        if data:
+            buffer.extend(data)
+            if len(buffer) > self.max_length:
+                logger.info(
+                    f"Host clipboard exceeds {self.max_length} bytes, not syncing"
+                )
+                stream.close_async(GLib.PRIORITY_DEFAULT, None, None)
+                return
+            self._read_chunk(stream, buffer, cancellable, paste)
+            return
+
+        stream.close_async(GLib.PRIORITY_DEFAULT, None, None)
+        if cancellable is self._cancellable:
+            self._cancellable = None
+        self._send_to_device(bytes(buffer), paste)
+
+    def _send_to_device(self, data: bytes, paste: bool = False) -> None:
+        if not data:
+            return
+        digest = self._hash(data)
+        # 粘贴时即使内容已经同步过也要发送
+        if digest == self._last_hash and not paste:
+            return
+        self._last_hash = digest
+
+        # 超过 max_length 的内容在读取时已被拒绝，这里不会截断；只丢弃无效的 UTF-8 字节
+        text = data.decode("utf-8", errors="ignore")
+        self._sequence += 1
+        msg = SetClipboardMsg(text, paste=paste, sequence=self._sequence)
+        if self.latency_probe is not None:
+            self.latency_probe.track(self._sequence, len(data))
+        self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
+        logger.debug(f"Host clipboard sent to device ({len(data)} bytes, seq {self._sequence})")
+
+    # 设备 -> 主机
+
+    def _on_device_msg(self, event: Event[Any]) -> None:
+        msg = event.data
+        if isinstance(msg, ClipboardDeviceMsg):
+            self._set_host_text(msg.text)
+        elif isinstance(msg, AckClipboardDeviceMsg):
+            logger.debug(f"Device acknowledged clipboard seq {msg.sequence}")
+
+    def _set_host_text(self, text: str) -> None:
+        digest = self._hash(text.encode("utf-8"))
+        if digest == self._last_hash:
+            return
+        self._last_hash = digest
+        # 设备的新内容优先，放弃还在读取的主机内容
+        self._cancel_read()
+        self.clipboard.set(text)
+        logger.debug("Device clipboard copied to host")
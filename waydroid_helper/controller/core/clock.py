@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""
+时钟与定时器
+组件通过这里读取时间、注册定时器和等待，而不是直接调用 time / GLib / asyncio，
+这样同一套逻辑既能跑在真实时间上，也能在模拟器里跑在虚拟时间上
+"""
+
+import asyncio
+import heapq
+import time
+from typing import Any, Callable
+
+import gi
+
+gi.require_version("GLib", "2.0")
+from gi.repository import GLib
+
+from waydroid_helper.util.idle import callback_source, counted
+
+# 与 GLib.timeout_add 相同：返回 True 继续，返回 False 移除
+TimeoutCallback = Callable[..., bool]
+
+
+class Clock:
+    """时钟接口，时间单位为秒，没有固定起点，只能用来计算间隔"""
+
+    def now(self) -> float:
+        raise NotImplementedError
+
+    def timeout_add(self, interval_ms: int, callback: TimeoutCallback, *args: Any) -> int:
+        raise NotImplementedError
+
+    def source_remove(self, source_id: int) -> None:
+        raise NotImplementedError
+
+    async def sleep(self, seconds: float) -> None:
+        raise NotImplementedError
+
+
+class SystemClock(Clock):
+    """真实时钟：time.monotonic + GLib 主循环定时器 + asyncio.sleep"""
+
+    def now(self) -> float:
+        return time.monotonic()
+
+    def timeout_add(self, interval_ms: int, callback: TimeoutCallback, *args: Any) -> int:
+        # 每次触发都计入唤醒统计
+        return GLib.timeout_add(interval_ms, counted(callback_source(callback), callback), *args)
+
+    def source_remove(self, source_id: int) -> None:
+        GLib.source_remove(source_id)
+
+    async def sleep(self, seconds: float) -> None:
+        await asyncio.sleep(seconds)
+
+
+class VirtualClock(Clock):
+    """
+    虚拟时钟
+
+    Time only moves when advance() or advance_to() is called. Timers that
+    fall inside the advanced span fire in deadline order with now() set to
+    their deadline; timers with equal deadlines fire in registration order.
+    sleep() is a timer that resolves an asyncio future, so the awaiting
+    coroutine resumes the next time the event loop runs.
+    """
+
+    def __init__(self, start: float = 0.0):
+        self._now: float = start
+        self._next_id: int = 1
+        self._sequence: int = 0
+        # (deadline, sequence, source_id)
+        self._queue: list[tuple[float, int, int]] = []
+        self._timers: dict[int, tuple[float, TimeoutCallback, tuple[Any, ...]]] = {}
+
+    def now(self) -> float:
+        return self._now
+
+    def timeout_add(self, interval_ms: int, callback: TimeoutCallback, *args: Any) -> int:
+        source_id = self._next_id
+        self._next_id += 1
+        interval = max(0, interval_ms) / 1000.0
+        self._timers[source_id] = (interval, callback, args)
+        self._schedule(source_id, self._now + interval)
+        return source_id
+
+    def source_remove(self, source_id: int) -> None:
+        # 堆里的条目留到出队时再丢弃
+        self._timers.pop(source_id, None)
+
+    async def sleep(self, seconds: float) -> None:
+        future: asyncio.Future[None] = asyncio.get_running_loop().create_future()
+
+        def wake() -> bool:
+            if not future.done():
+                future.set_result(None)
+            return False
+
+        source_id = self.timeout_add(int(round(max(0.0, seconds) * 1000)), wake)
+        try:
+            await future
+        finally:
+            self.source_remove(source_id)
+
+    def _schedule(self, source_id: int, deadline: float) -> None:
+        self._sequence += 1
+        heapq.heappush(self._queue, (deadline, self._sequence, source_id))
+
+    def next_deadline(self) -> float | None:
+        """最近一个定时器的到期时间，没有定时器时返回 None"""
+        while self._queue and self._queue[0][2] not in self._timers:
+            heapq.heappop(self._queue)
+        return self._queue[0][0] if self._queue else None
+
+    @property
+    def pending(self) -> int:
+        return len(self._timers)
+
+    def fire_due(self) -> int:
+        """触发所有已到期的定时器，返回触发数量"""
+        fired = 0
+        while True:
+            deadline = self.next_deadline()
+            if deadline is None or deadline > self._now:
+                return fired
+            _, _, source_id = heapq.heappop(self._queue)
+            interval, callback, args = self._timers[source_id]
+            fired += 1
+            if callback(*args) and source_id in self._timers:
+                # 和 GLib 一样从本次触发时刻重新计时
+                self._schedule(source_id, self._now + interval)
+            else:
+                self._timers.pop(source_id, None)
+
+    def advance_to(self, deadline: float) -> int:
+        """把时间推进到 deadline，途中的定时器按顺序触发"""
+        fired = 0
+        while True:
+            next_deadline = self.next_deadline()
+            if next_deadline is None or next_deadline > deadline:
+                break
+            self._now = max(self._now, next_deadline)
+            fired += self.fire_due()
+        self._now = max(self._now, deadline)
+        return fired
+
+    def advance(self, seconds: float) -> int:
+        return self.advance_to(self._now + seconds)
+
+
+_clock: Clock = SystemClock()
+
+
+def get_clock() -> Clock:
+    """当前全局时钟"""
+    return _clock
+
+
+def set_clock(clock: Clock | None) -> Clock:
+    """替换全局时钟，传 None 恢复真实时钟，返回之前的时钟"""
+    global _clock
+    previous = _clock
+    _clock = clock if clock is not None else SystemClock()
+    return previous
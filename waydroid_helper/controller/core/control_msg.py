@@ -92,6 +92,35 @@ class ControlMsgType(IntEnum):
     UHID_INPUT = 13
     OPEN_HARD_KEYBOARD_SETTINGS = 14
 
+
+# scrcpy server 对文本长度（UTF-8 字节数）的限制
+INJECT_TEXT_MAX_LENGTH = 300
+# 单条控制消息最大 256KiB，减去 SET_CLIPBOARD 的头部
+CLIPBOARD_TEXT_MAX_LENGTH = (1 << 18) - 14
+
+
+class GetClipboardCopyKey(IntEnum):
+    NONE = 0
+    COPY = 1
+    CUT = 2
+
+
+def split_utf8(text: str, max_bytes: int) -> list[str]:
+    """按 UTF-8 字节数切分文本，不会切断多字节字符"""
+    chunks: list[str] = []
+    start = 0
+    size = 0
+    for i, char in enumerate(text):
+        char_size = len(char.encode("utf-8"))
+        if size + char_size > max_bytes and i > start:
+            chunks.append(text[start:i])
+            start = i
+            size = 0
+        size += char_size
+    if start < len(text):
+        chunks.append(text[start:])
+    return chunks
+
 def to_fixed_point_u16(f_val: float) -> int:
     """优化版本：将浮点数转换为 Q16 格式的定点数，移除分支预测"""
     # 使用 max/min 进行 clamp，比 if 语句更高效
@@ -220,3 +249,37 @@ class InjectScrollEventMsg(ControlMsg):
             vscroll_fixed,
             self.buttons,
         )
+
+
+@dataclass
+class GetClipboardMsg(ControlMsg):
+    copy_key: GetClipboardCopyKey | int = GetClipboardCopyKey.NONE
+
+    @property
+    def msg_type(self) -> ControlMsgType:
+        return ControlMsgType.GET_CLIPBOARD
+
+    def pack(self) -> bytes:
+        return struct.pack(">BB", self.msg_type, self.copy_key)
+
+
+@dataclass
+class SetClipboardMsg(ControlMsg):
+    text: str
+    paste: bool = False
+    # 非 0 时设备在设置完成后回复 ACK_CLIPBOARD
+    sequence: int = 0
+
+    @property
+    def msg_type(self) -> ControlMsgType:
+        return ControlMsgType.SET_CLIPBOARD
+
+    def pack(self) -> bytes:
+        text_bytes = self.text.encode('utf-8')
+        if len(text_bytes) > CLIPBOARD_TEXT_MAX_LENGTH:
+            # 截断时不能切断多字节字符
+            text_bytes = split_utf8(self.text, CLIPBOARD_TEXT_MAX_LENGTH)[0].encode('utf-8')
+        return (
+            struct.pack(">BQBI", self.msg_type, self.sequence, self.paste, len(text_bytes))
+            + text_bytes
+        )
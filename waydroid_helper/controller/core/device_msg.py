@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+设备消息模块
+解析 scrcpy server 通过控制 socket 发回的消息
+"""
+import asyncio
+import struct
+from dataclasses import dataclass
+from enum import IntEnum
+
+# 与 scrcpy server 的 DeviceMessageWriter 保持一致
+DEVICE_MSG_MAX_SIZE = 1 << 18
+
+
+class DeviceMsgType(IntEnum):
+    CLIPBOARD = 0
+    ACK_CLIPBOARD = 1
+    UHID_OUTPUT = 2
+
+
+@dataclass
+class DeviceMsg:
+    @property
+    def msg_type(self) -> DeviceMsgType:
+        raise NotImplementedError
+
+
+@dataclass
+class ClipboardDeviceMsg(DeviceMsg):
+    text: str
+
+    @property
+    def msg_type(self) -> DeviceMsgType:
+        return DeviceMsgType.CLIPBOARD
+
+
+@dataclass
+class AckClipboardDeviceMsg(DeviceMsg):
+    sequence: int
+
+    @property
+    def msg_type(self) -> DeviceMsgType:
+        return DeviceMsgType.ACK_CLIPBOARD
+
+
+@dataclass
+class UhidOutputDeviceMsg(DeviceMsg):
+    id: int
+    data: bytes
+
+    @property
+    def msg_type(self) -> DeviceMsgType:
+        return DeviceMsgType.UHID_OUTPUT
+
+
+async def read_device_msg(reader: asyncio.StreamReader) -> DeviceMsg:
+    """
+    读取一条设备消息
+
+    Raises:
+        asyncio.IncompleteReadError: The connection was closed
+        ValueError: Unknown or malformed message; the stream cannot be resynchronized
+    """
+    msg_type = (await reader.readexactly(1))[0]
+
+    if msg_type == DeviceMsgType.CLIPBOARD:
+        (length,) = struct.unpack(">I", await reader.readexactly(4))
+        if length > DEVICE_MSG_MAX_SIZE:
+            raise ValueError(f"Clipboard message too large: {length}")
+        text = (await reader.readexactly(length)).decode("utf-8", errors="replace")
+        return ClipboardDeviceMsg(text)
+
+    if msg_type == DeviceMsgType.ACK_CLIPBOARD:
+        (sequence,) = struct.unpack(">Q", await reader.readexactly(8))
+        return AckClipboardDeviceMsg(sequence)
+
+    if msg_type == DeviceMsgType.UHID_OUTPUT:
+        uhid_id, size = struct.unpack(">HH", await reader.readexactly(4))
+        return UhidOutputDeviceMsg(uhid_id, await reader.readexactly(size))
+
+    raise ValueError(f"Unknown device message type: {msg_type}")
@@ -5,6 +5,8 @@
 """
 
 import threading
+import weakref
+from collections import deque
 from dataclasses import dataclass, field
 from enum import Enum
 from typing import Any, Callable, Dict, Generic, List, TypeVar
@@ -12,7 +14,7 @@ from typing import Any, Callable, Dict, Generic, List, TypeVar
 import gi
 
 gi.require_version("GObject", "2.0")
-from gi.repository import GObject
+from gi.repository import GLib, GObject
 
 from waydroid_helper.util.log import logger
 
@@ -32,6 +34,7 @@ class EventType(str, Enum):
 
     # ControlMsg
     CONTROL_MSG = "control-msg"  # 控制消息
+    DEVICE_MSG = "device-msg"  # 设备发回的消息
 
     # 宏命令事件
     MACRO_KEY_PRESSED = "macro-key-pressed"  # 宏命令按键按下
@@ -54,13 +57,31 @@ class EventType(str, Enum):
     RIGHT_CLICK_TO_WALK_OVERLAY = "right-click-to-walk-overlay"  # 右键行走校准覆盖层
 
 
+@dataclass(eq=False)
+class SubscriberEntry:
+    """一个订阅者的订阅：handler_id 集合和总线替它持有的处理器"""
+    ref: Callable[[], Any]
+    handler_ids: set[int] = field(default_factory=set)
+    # 非方法的处理器和过滤器，随订阅一起释放
+    owned: List[Any] = field(default_factory=list)
+    finalizer: "weakref.finalize | None" = None
+
+
 @dataclass
 class HandlerInfo:
     """处理器信息"""
     handler_id: int
     priority: int = 0
-    filter_func: Callable[[Any, Any, Any], bool] | None = None
-    subscriber: Any = None
+    filter_ref: Callable[[], Any] | None = None
+    # 订阅者只保存弱引用（不支持弱引用的对象除外）
+    subscriber_ref: Callable[[], Any] | None = None
+    event_type: "EventType | None" = None
+    connection_id: int = 0
+    handler_ref: Callable[[], Any] | None = None
+
+    @property
+    def subscriber(self) -> Any:
+        return self.subscriber_ref() if self.subscriber_ref is not None else None
 
 
 class GlobalEventEmitter(GObject.Object):
@@ -80,6 +101,7 @@ class GlobalEventEmitter(GObject.Object):
 
         # ControlMsg
         EventType.CONTROL_MSG: (GObject.SignalFlags.RUN_FIRST, None, (object, object)),
+        EventType.DEVICE_MSG: (GObject.SignalFlags.RUN_FIRST, None, (object, object)),
 
         # 宏命令事件
         EventType.MACRO_KEY_PRESSED: (GObject.SignalFlags.RUN_FIRST, None, (object, object)),
@@ -152,7 +174,21 @@ class Event(Generic[T]):
 
 
 class EventBus:
-    """事件总线 - 基于GTK信号系统的兼容层 (严格单例模式)"""
+    """
+    事件总线 - 基于GTK信号系统的兼容层 (严格单例模式)
+
+    Subscriptions do not keep their subscriber alive. Bound-method handlers
+    are held through weakref.WeakMethod and their object is the subscriber
+    when none is given. Other handlers and filters (lambdas, closures) are
+    held by the bus in the subscriber's entry and released with its
+    subscriptions; a closure that captures its own subscriber keeps it
+    alive until unsubscribe_by_subscriber(), so prefer bound methods.
+    When a subscriber is collected, its subscriptions are removed through
+    the per-subscriber index without scanning the other event types. The
+    collection can happen on any thread, so the collected entries are
+    queued and removed on the main loop (GLib.idle_add); code that runs
+    its own loop can call process_collected() instead.
+    """
 
     _instance = None
     _lock = threading.Lock()
@@ -177,15 +213,56 @@ class EventBus:
             # 获取全局事件发射器单例
             self._emitter = GlobalEventEmitter()
 
-            # 存储处理器信息用于优先级和过滤
-            self._handler_info: Dict[EventType, List[HandlerInfo]] = {}
+            # 存储处理器信息用于优先级和过滤（按事件类型，handler_id -> 信息）
+            self._handler_info: Dict[EventType, Dict[int, HandlerInfo]] = {}
 
             # 存储连接ID用于断开连接
             self._connections: Dict[int, int] = {}  # handler_id -> connection_id
+            self._handlers: Dict[int, HandlerInfo] = {}
             self._next_handler_id = 1
 
+            # 订阅者索引：id(订阅者) -> 订阅记录
+            self._by_subscriber: Dict[int, SubscriberEntry] = {}
+            # 已回收、等待在主循环里清理的订阅者；任何线程都可能追加
+            self._collected: deque[tuple[int, SubscriberEntry]] = deque()
+            self._collect_scheduled = False
+
             EventBus._initialized = True
 
+    @property
+    def subscription_count(self) -> int:
+        """当前存活的订阅数量"""
+        return len(self._handlers)
+
+    @property
+    def subscriber_count(self) -> int:
+        return len(self._by_subscriber)
+
+    def handler_counts(self) -> Dict[str, int]:
+        """
+        按事件类型统计处理器数量
+
+        Counts the HandlerInfo entries of both EventBus and the
+        GlobalEventEmitter, keyed by the event type's value.
+        """
+        counts: Dict[str, int] = {}
+        for info in (self._handler_info, self._emitter._handler_info):
+            for event_type, handlers in info.items():
+                counts[event_type.value] = counts.get(event_type.value, 0) + len(handlers)
+        return counts
+
+    def _own(self, obj: Callable[..., Any], entry: SubscriberEntry | None) -> Callable[[], Any]:
+        """把 obj 放进订阅者的记录里，返回对 obj 的引用；没有订阅者时退回强引用"""
+        if entry is not None:
+            try:
+                ref = weakref.ref(obj)
+            except TypeError:
+                pass
+            else:
+                entry.owned.append(obj)
+                return ref
+        return lambda: obj
+
     def subscribe(
         self,
         event_type: EventType,
@@ -200,41 +277,148 @@ class EventBus:
         :param handler: 处理函数
         :param filter: 可选的事件过滤器
         :param priority: 处理优先级
-        :param subscriber: 订阅者对象（用于批量取消订阅）
+        :param subscriber: 订阅者对象（用于批量取消订阅）；绑定方法默认为其所属对象
         """
-        # 创建包装处理器来处理优先级和过滤
+        if subscriber is None:
+            subscriber = getattr(handler, "__self__", None)
+
+        # 生成处理器ID
+        handler_id = self._next_handler_id
+        self._next_handler_id += 1
+
+        entry = self._track_subscriber(subscriber, handler_id) if subscriber is not None else None
+
+        try:
+            handler_ref: Callable[[], Any] = weakref.WeakMethod(handler)  # type: ignore[arg-type]
+        except TypeError:
+            # 不是绑定方法，或者所属对象不支持弱引用
+            handler_ref = self._own(handler, entry)
+        filter_ref = self._own(filter, entry) if filter is not None else None
+
+        # 创建包装处理器来处理优先级和过滤，只通过弱引用找到处理器
         def wrapped_handler(emitter, source, data):
+            current_handler = handler_ref()
+            current_filter = filter_ref() if filter_ref is not None else None
+            if current_handler is None or (filter_ref is not None and current_filter is None):
+                # 订阅者已被回收
+                self._remove_handler(handler_id)
+                return
+
             # 创建Event对象
             event = Event(event_type, source, data)
 
             # 应用过滤器
-            if filter and not filter(event):
+            if current_filter and not current_filter(event):
                 return
 
             # 调用原始处理器
             try:
-                handler(event)
+                current_handler(event)
             except Exception as e:
                 logger.error(f"Failed to handle event {event_type.value}: {e}")
 
         # 连接GTK信号
         connection_id = self._emitter.connect(event_type.value, wrapped_handler)
 
-        # 生成处理器ID
-        handler_id = self._next_handler_id
-        self._next_handler_id += 1
+        subscriber_ref = entry.ref if entry is not None else None
 
         # 存储处理器信息
-        if event_type not in self._handler_info:
-            self._handler_info[event_type] = []
-
-        info = HandlerInfo(handler_id, priority, filter, subscriber)
-        self._handler_info[event_type].append(info)
+        info = HandlerInfo(
+            handler_id, priority, filter_ref, subscriber_ref, event_type, connection_id, handler_ref
+        )
+        self._handler_info.setdefault(event_type, {})[handler_id] = info
+        self._handlers[handler_id] = info
         self._connections[handler_id] = connection_id
 
         # 按优先级重新排序连接（需要断开重连来保证顺序）
         self._reorder_handlers(event_type)
 
+    def _track_subscriber(self, subscriber: Any, handler_id: int) -> SubscriberEntry:
+        key = id(subscriber)
+        entry = self._by_subscriber.get(key)
+        if entry is None or entry.ref() is not subscriber:
+            # 新订阅者；id 相同但旧记录的对象已被回收时，旧记录由回收回调清理
+            entry = self._new_entry(subscriber)
+            self._by_subscriber[key] = entry
+        entry.handler_ids.add(handler_id)
+        return entry
+
+    def _new_entry(self, subscriber: Any) -> SubscriberEntry:
+        try:
+            entry = SubscriberEntry(weakref.ref(subscriber))
+        except TypeError:
+            # 不支持弱引用的订阅者只能手动取消订阅
+            return SubscriberEntry(lambda: subscriber)
+        entry.finalizer = weakref.finalize(
+            subscriber, self._on_subscriber_collected, id(subscriber), entry
+        )
+        # 退出时不需要逐个清理
+        entry.finalizer.atexit = False
+        return entry
+
+    def _on_subscriber_collected(self, key: int, entry: SubscriberEntry) -> None:
+        # 垃圾回收可能发生在任何线程，回到主循环再修改订阅表
+        self._collected.append((key, entry))
+        if not self._collect_scheduled:
+            self._collect_scheduled = True
+            GLib.idle_add(self._on_collect_idle)
+
+    def _on_collect_idle(self) -> bool:
+        self._collect_scheduled = False
+        self.process_collected()
+        return False
+
+    def process_collected(self) -> int:
+        """移除已回收订阅者的订阅，返回移除的数量；只在主线程调用"""
+        removed = 0
+        while self._collected:
+            key, entry = self._collected.popleft()
+            if self._by_subscriber.get(key) is entry:
+                del self._by_subscriber[key]
+            for handler_id in entry.handler_ids:
+                if self._remove_handler(handler_id, update_index=False):
+                    removed += 1
+            entry.handler_ids.clear()
+            entry.owned.clear()
+        if removed:
+            logger.debug(f"Removed {removed} subscriptions of collected subscribers")
+        return removed
+
+    def _remove_handler(self, handler_id: int, update_index: bool = True) -> bool:
+        info = self._handlers.pop(handler_id, None)
+        if info is None:
+            return False
+        self._connections.pop(handler_id, None)
+        try:
+            self._emitter.disconnect(info.connection_id)
+        except TypeError:
+            # 连接已经断开
+            pass
+        if info.event_type is not None:
+            handlers = self._handler_info.get(info.event_type)
+            if handlers is not None:
+                handlers.pop(handler_id, None)
+                if not handlers:
+                    del self._handler_info[info.event_type]
+        if update_index and info.subscriber_ref is not None:
+            subscriber = info.subscriber_ref()
+            if subscriber is not None:
+                key = id(subscriber)
+                entry = self._by_subscriber.get(key)
+                if entry is not None and entry.ref() is subscriber:
+                    entry.handler_ids.discard(handler_id)
+                    if not entry.handler_ids:
+                        self._forget_subscriber(key)
+        return True
+
+    def _forget_subscriber(self, key: int) -> None:
+        entry = self._by_subscriber.pop(key, None)
+        if entry is None:
+            return
+        if entry.finalizer is not None:
+            entry.finalizer.detach()
+        entry.handler_ids.clear()
+        entry.owned.clear()
 
     def _reorder_handlers(self, event_type: EventType) -> None:
         """按优先级重新排序处理器"""
@@ -242,7 +426,11 @@ class EventBus:
             return
 
         # 按优先级排序
-        self._handler_info[event_type].sort(key=lambda h: h.priority, reverse=True)
+        handlers = self._handler_info[event_type]
+        if len(handlers) > 1:
+            self._handler_info[event_type] = dict(
+                sorted(handlers.items(), key=lambda item: item[1].priority, reverse=True)
+            )
 
         # 注意：GTK信号的调用顺序由连接顺序决定，
         # 如果需要严格的优先级控制，可能需要在包装处理器中实现
@@ -250,9 +438,10 @@ class EventBus:
     def unsubscribe(
         self, event_type: EventType, handler: Callable[[Event[Any]], None]
     ) -> bool:
-        """取消事件订阅"""
-        # 注意：由于我们使用了包装处理器，直接按handler取消订阅比较困难
-        # 这个方法主要为了兼容性，实际使用中建议使用unsubscribe_by_subscriber
+        """取消事件订阅，按处理器相等比较，取消第一个匹配的订阅"""
+        for handler_id, info in list(self._handler_info.get(event_type, {}).items()):
+            if info.handler_ref is not None and info.handler_ref() == handler:
+                return self._remove_handler(handler_id)
         return False
 
     def unsubscribe_by_subscriber(self, subscriber: Any) -> int:
@@ -261,27 +450,16 @@ class EventBus:
         :param subscriber: 订阅者对象
         :return: 取消的订阅数量
         """
-        unsubscribed_count = 0
-        subscriber_id = id(subscriber)
-
-        for event_type in list(self._handler_info.keys()):
-            handlers_to_remove = []
-
-            for handler_info in self._handler_info[event_type]:
-                if handler_info.subscriber is not None and id(handler_info.subscriber) == subscriber_id:
-                    # 断开GTK信号连接
-                    connection_id = self._connections.get(handler_info.handler_id)
-                    if connection_id is not None:
-                        self._emitter.disconnect(connection_id)
-                        del self._connections[handler_info.handler_id]
-
-                    handlers_to_remove.append(handler_info)
-                    unsubscribed_count += 1
-
-            # 从列表中移除处理器信息
-            for handler_info in handlers_to_remove:
-                self._handler_info[event_type].remove(handler_info)
+        key = id(subscriber)
+        entry = self._by_subscriber.get(key)
+        if entry is None or entry.ref() is not subscriber:
+            return 0
 
+        unsubscribed_count = 0
+        for handler_id in list(entry.handler_ids):
+            if self._remove_handler(handler_id, update_index=False):
+                unsubscribed_count += 1
+        self._forget_subscriber(key)
         return unsubscribed_count
 
     def emit(self, event: Event[Any]) -> None:
@@ -298,9 +476,16 @@ class EventBus:
         for connection_id in self._connections.values():
             self._emitter.disconnect(connection_id)
 
+        for entry in self._by_subscriber.values():
+            if entry.finalizer is not None:
+                entry.finalizer.detach()
+
         # 清空所有数据结构
         self._connections.clear()
+        self._handlers.clear()
         self._handler_info.clear()
+        self._by_subscriber.clear()
+        self._collected.clear()
 
     @classmethod
     def reset_singleton(cls) -> None:
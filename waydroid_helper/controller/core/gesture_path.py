@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+手势路径
+宏的 swipe/drag/pinch 命令用到的路径解析、缓动和按弧长取点，不依赖 Gtk
+"""
+
+import math
+from typing import Callable
+
+# 缓动函数：输入和输出都在 [0, 1]
+EASINGS: dict[str, Callable[[float], float]] = {
+    "linear": lambda t: t,
+    "ease_in": lambda t: t * t,
+    "ease_out": lambda t: 1 - (1 - t) * (1 - t),
+    "ease_in_out": lambda t: 3 * t * t - 2 * t * t * t,
+}
+
+
+def parse_point(point: str) -> bool:
+    """point 是否为 "x,y" 整数坐标或 "mouse" """
+    if point == "mouse":
+        return True
+    try:
+        x, y = point.split(",")
+        int(x), int(y)
+    except ValueError:
+        return False
+    return True
+
+
+def path_sampler(path: list[tuple[float, float]]) -> Callable[[float], tuple[float, float]]:
+    """
+    按弧长在折线上取点
+
+    The returned function maps a fraction in [0, 1] of the total length to
+    a position; a path of zero length always returns its last point.
+    """
+    lengths = [0.0]
+    for (x0, y0), (x1, y1) in zip(path, path[1:]):
+        lengths.append(lengths[-1] + math.hypot(x1 - x0, y1 - y0))
+    total = lengths[-1]
+
+    def sample(fraction: float) -> tuple[float, float]:
+        if total <= 0:
+            return path[-1]
+        distance = fraction * total
+        for index in range(1, len(path)):
+            if distance <= lengths[index] or index == len(path) - 1:
+                span = lengths[index] - lengths[index - 1]
+                local = (distance - lengths[index - 1]) / span if span > 0 else 1.0
+                (x0, y0), (x1, y1) = path[index - 1], path[index]
+                return x0 + (x1 - x0) * local, y0 + (y1 - y0) * local
+        return path[-1]
+
+    return sample
+
+
+def parse_gesture(args: list[str]) -> tuple[list[list[str]], float, str] | None:
+    """
+    解析 <路径> [+ <路径> ...] <毫秒> [缓动]
+
+    A path is two or more "x,y" or "mouse" points; "+" separates the
+    paths of different fingers. Returns (fingers, seconds, easing) or None.
+    """
+    tokens = list(args)
+    easing = "linear"
+    if tokens and tokens[-1] in EASINGS:
+        easing = tokens.pop()
+    if not tokens:
+        return None
+    try:
+        duration = int(tokens.pop()) / 1000
+    except ValueError:
+        return None
+
+    fingers: list[list[str]] = [[]]
+    for token in tokens:
+        if token == "+":
+            fingers.append([])
+        elif parse_point(token):
+            fingers[-1].append(token)
+        else:
+            return None
+    if any(len(finger) < 2 for finger in fingers):
+        return None
+    return fingers, duration, easing
+
+
+def parse_pinch(args: list[str]) -> tuple[str, float, float, float, float, str] | None:
+    """
+    解析 <中心> <起始半径> <结束半径> <毫秒> [角度] [缓动]
+
+    Returns (center, start_radius, end_radius, seconds, degrees, easing)
+    or None.
+    """
+    tokens = list(args)
+    easing = "linear"
+    if tokens and tokens[-1] in EASINGS:
+        easing = tokens.pop()
+    if len(tokens) not in (4, 5) or not parse_point(tokens[0]):
+        return None
+    try:
+        start_radius = float(tokens[1])
+        end_radius = float(tokens[2])
+        duration = int(tokens[3]) / 1000
+        angle = float(tokens[4]) if len(tokens) == 5 else 0.0
+    except ValueError:
+        return None
+    return tokens[0], start_radius, end_radius, duration, angle, easing
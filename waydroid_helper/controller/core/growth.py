@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""
+持续增长判断
+长时间运行检查用到的判断规则，只处理采样数值，不依赖 Gtk
+"""
+
+from typing import Any, Mapping, Sequence
+
+# 去掉预热部分后至少需要的采样数
+MIN_SAMPLES = 6
+
+
+def growth_failures(
+    samples: Sequence[Any],
+    tolerances: Mapping[str, float],
+    warmup_fraction: float = 0.2,
+) -> list[str] | None:
+    """
+    找出持续增长的指标，采样不够时返回 None
+
+    The first warmup_fraction of the samples is dropped. A metric in
+    tolerances fails when every remaining sample in the last third is above
+    every sample in the first third and the mean grew by more than its
+    tolerance. When the samples carry handlers_by_event, each event type
+    whose count grew by more than the "handlers" tolerance between the
+    first and last sample is reported too.
+    """
+    samples = samples[int(len(samples) * warmup_fraction):]
+    if len(samples) < MIN_SAMPLES:
+        return None
+
+    failures: list[str] = []
+    third = len(samples) // 3
+    head, tail = samples[:third], samples[-third:]
+    for metric, tolerance in tolerances.items():
+        head_values = [getattr(s, metric) for s in head]
+        tail_values = [getattr(s, metric) for s in tail]
+        growth = sum(tail_values) / len(tail_values) - sum(head_values) / len(head_values)
+        if min(tail_values) > max(head_values) and growth > tolerance:
+            failures.append(f"{metric} grew by {growth:.0f}")
+
+    # 按事件类型指出是哪个订阅在增长
+    first = getattr(samples[0], "handlers_by_event", {})
+    last = getattr(samples[-1], "handlers_by_event", {})
+    handler_tolerance = tolerances.get("handlers", 0)
+    for event_name, count in last.items():
+        if count - first.get(event_name, 0) > handler_tolerance:
+            failures.append(f"{event_name} handlers {first.get(event_name, 0)} -> {count}")
+    return failures
@@ -36,6 +36,7 @@ class DefaultEventHandler(InputEventHandler):
             "mouse_release": self._handle_default_mouse_release,
             "mouse_motion": self._handle_default_mouse_motion,
             "mouse_scroll": self._handle_default_mouse_scroll,
+            "mouse_scroll_decelerate": self._handle_default_mouse_scroll_decelerate,
             "mouse_zoom": self._handle_default_mouse_zoom,
         }
 
@@ -162,6 +163,14 @@ class DefaultEventHandler(InputEventHandler):
         )
         return True
 
+    def _handle_default_mouse_scroll_decelerate(self, event: InputEvent) -> bool:
+        """处理触控板滚动结束后的惯性速度"""
+        if not event.raw_data:
+            return False
+        return self.mouse_handler.scroll_decelerate_processor(
+            event.raw_data["controller"], event.raw_data["vel_x"], event.raw_data["vel_y"]
+        )
+
     def _handle_default_mouse_zoom(self, event: InputEvent) -> bool:
         """处理默认鼠标缩放"""
         if not event.raw_data:
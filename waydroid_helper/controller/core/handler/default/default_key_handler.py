@@ -11,8 +11,10 @@ import gi
 
 from waydroid_helper.controller.android import (AKeyCode, AKeyEventAction,
                                                 AMetaState)
-from waydroid_helper.controller.core.control_msg import (InjectKeycodeMsg,
-                                                         InjectTextMsg)
+from waydroid_helper.controller.core.control_msg import (
+    INJECT_TEXT_MAX_LENGTH, ControlMsg, InjectKeycodeMsg, InjectTextMsg,
+    split_utf8)
+from waydroid_helper.controller.core.clock import get_clock
 from waydroid_helper.controller.core.event_bus import (Event, EventType,
                                                        EventBus)
 
@@ -38,6 +40,9 @@ class KeyboardBase(ABC):
 
 
 class KeyboardDefault(KeyboardBase):
+    # 在这个时间窗口内输入的文本合并为一条 InjectTextMsg
+    TEXT_COALESCE_MS = 15
+
     # 所有模式都用
     special_keys: dict[int, AKeyCode] = {
         Gdk.KEY_Return: AKeyCode.AKEYCODE_ENTER,
@@ -154,6 +159,8 @@ class KeyboardDefault(KeyboardBase):
         self.key_repeat: int = 0
         # TODO 从配置中读取
         self.inject_mode: KeyInjectMode = KeyInjectMode.MIXED
+        self._pending_text: list[str] = []
+        self._text_timer_id: int | None = None
 
     def convert_action(self, event: Gdk.Event) -> AKeyEventAction:
         if event.get_event_type() == Gdk.EventType.KEY_PRESS:
@@ -288,6 +295,8 @@ class KeyboardDefault(KeyboardBase):
             self.get_reapeat(keyval, action),
             metastate,
         )
+        # 先发出之前合并的文本，保证与按键事件的顺序一致
+        self.flush_text()
         self.event_bus.emit(Event[InjectKeycodeMsg](EventType.CONTROL_MSG, self, msg))
         return True
 
@@ -302,7 +311,54 @@ class KeyboardDefault(KeyboardBase):
             text = self.convert_text(keyval)
             if text is None:
                 return False
-            msg = InjectTextMsg(text)
-            self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
+            self.queue_text(text)
             return True
         return False
+
+    def queue_text(self, text: str) -> None:
+        """
+        输入文本
+
+        The first text after an idle period is sent at once; text arriving
+        within TEXT_COALESCE_MS after that is merged and sent when the window
+        closes, so bursts (IME commits, typed pastes) become one message.
+        """
+        if self._text_timer_id is None:
+            self.inject_text(text)
+            self._text_timer_id = get_clock().timeout_add(
+                self.TEXT_COALESCE_MS, self._on_text_timeout
+            )
+            return
+        self._pending_text.append(text)
+
+    def _on_text_timeout(self) -> bool:
+        if not self._pending_text:
+            self._text_timer_id = None
+            return False
+        # 还有合并的文本，发送后继续保持窗口
+        self.inject_text("".join(self._pending_text))
+        self._pending_text.clear()
+        return True
+
+    def flush_text(self) -> None:
+        """立即发送合并中的文本"""
+        if self._text_timer_id is not None:
+            get_clock().source_remove(self._text_timer_id)
+            self._text_timer_id = None
+        if self._pending_text:
+            text = "".join(self._pending_text)
+            self._pending_text.clear()
+            self.inject_text(text)
+
+    def inject_text(self, text: str) -> None:
+        """
+        发送文本，按 scrcpy 的长度限制分段
+
+        Typed text is short; pasting host text goes through
+        ClipboardSync.paste_host_clipboard() instead.
+        """
+        for chunk in split_utf8(text, INJECT_TEXT_MAX_LENGTH):
+            self._emit(InjectTextMsg(chunk))
+
+    def _emit(self, msg: ControlMsg) -> None:
+        self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
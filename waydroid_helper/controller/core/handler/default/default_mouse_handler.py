@@ -4,22 +4,26 @@ from waydroid_helper.controller.core.handler.event_handlers import InputEvent
 
 gi.require_version("Gdk", "4.0")
 gi.require_version("GLib", "2.0")
+import math
 from abc import ABC, abstractmethod
 from enum import IntEnum
 from typing import TYPE_CHECKING, cast
 
-from gi.repository import Gdk, GLib
+from gi.repository import Gdk
 
 from waydroid_helper.controller.android.input import (
     AMotionEventAction,
     AMotionEventButtons,
 )
+from waydroid_helper.config.file_manager import ConfigManager as FileConfigManager
+from waydroid_helper.controller.core.clock import get_clock
 from waydroid_helper.controller.core.control_msg import (
     InjectScrollEventMsg,
     InjectTouchEventMsg,
     ScreenInfo,
 )
 from waydroid_helper.controller.core.event_bus import Event, EventType, EventBus
+from waydroid_helper.controller.core.motion_clock import MotionClock
 
 if TYPE_CHECKING:
     from gi.repository import Gtk
@@ -29,6 +33,7 @@ class PointerId(IntEnum):
     MOUSE = 2**64 - 1
     GENERIC_FINGER = 2**64 - 2
     VIRTUAL_FINGER = 2**64 - 3
+    SCROLL_FINGER = 2**64 - 4
 
 
 class MouseBase(ABC):
@@ -64,6 +69,369 @@ class MouseBase(ABC):
     #     pass
 
 
+class PinchZoomEngine:
+    """
+    双指缩放引擎
+
+    One zoom is one two-finger gesture: both fingers go down once around a
+    fixed anchor and MotionClock ticks move them a fraction of the way
+    towards the target spread, so wheel notches become smooth MOVE streams
+    instead of jumps. The spread range scales with the screen, which leaves
+    enough travel that a normal zoom never has to lift the fingers.
+    """
+
+    MIN_SPREAD = 20
+    # 最大半间距占较短边的比例
+    MAX_SPREAD_RATIO = 0.35
+    # 每个节拍向目标移动的比例
+    SMOOTHING = 0.35
+    # 滚轮缩放在没有新输入且已到达目标后结束手势
+    IDLE_TIMEOUT = 0.25
+    # 每个滚轮刻度的相对缩放
+    WHEEL_STEP = 0.15
+
+    def __init__(self, event_bus: EventBus, screen_info: ScreenInfo) -> None:
+        self.event_bus = event_bus
+        self.screen_info = screen_info
+        self._clock = MotionClock()
+        self._subscription_id: int | None = None
+        self._active = False
+        # 触控板捏合由 end 状态结束，滚轮缩放由空闲超时结束
+        self._from_touchpad = False
+        self._anchor_x = 0.0
+        self._anchor_y = 0.0
+        self._min_spread = float(self.MIN_SPREAD)
+        self._max_spread = float(self.MIN_SPREAD)
+        self._spread = 0.0
+        self._target_spread = 0.0
+        self._begin_spread = 0.0
+        self._sent_spread = -1
+        self._base_scale = 1.0
+        self._last_input_time = 0.0
+
+    @property
+    def active(self) -> bool:
+        return self._active
+
+    def _begin(self, x: float, y: float, zoom_in: bool, from_touchpad: bool) -> None:
+        w, h = self.screen_info.get_host_resolution()
+        max_spread = max(float(self.MIN_SPREAD), min(w, h) * self.MAX_SPREAD_RATIO)
+        # 锚点向内收，保证整个缩放范围内手指都在屏幕内
+        margin = max_spread + 1
+        self._anchor_x = min(max(x, margin), max(margin, w - margin))
+        self._anchor_y = min(max(y, margin), max(margin, h - margin))
+        self._min_spread = float(self.MIN_SPREAD)
+        self._max_spread = max_spread
+        # 从相反的一端开始，留出最大的行程
+        self._spread = self._min_spread if zoom_in else self._max_spread
+        self._target_spread = self._spread
+        self._begin_spread = self._spread
+        self._from_touchpad = from_touchpad
+        self._active = True
+        self._send(AMotionEventAction.DOWN, self._spread, 1.0)
+        if not self._clock.is_subscribed(self._subscription_id):
+            self._subscription_id = self._clock.subscribe(self._on_tick)
+
+    def pinch_begin(self) -> None:
+        # 等到第一次 scale-changed 才知道缩放方向
+        self.end()
+        self._base_scale = 1.0
+
+    def pinch_scale(self, x: float, y: float, scale: float) -> None:
+        """触控板捏合，scale 为相对手势开始时的绝对比例"""
+        if scale <= 0:
+            return
+        if not self._active:
+            self._begin(x, y, scale > 1, True)
+            self._base_scale = scale
+        self._last_input_time = get_clock().now()
+        self._set_target(self._begin_spread * scale / self._base_scale)
+
+    def wheel(self, x: float, y: float, notches: float) -> None:
+        """滚轮缩放，notches > 0 表示放大"""
+        if notches == 0:
+            return
+        if self._active and self._is_saturated(notches):
+            # 已经到达行程尽头，只能抬起后重新开始
+            self.end()
+        if not self._active:
+            self._begin(x, y, notches > 0, False)
+        self._last_input_time = get_clock().now()
+        self._set_target(self._target_spread * (1 + self.WHEEL_STEP) ** notches)
+
+    def _is_saturated(self, notches: float) -> bool:
+        if notches > 0:
+            return self._target_spread >= self._max_spread
+        return self._target_spread <= self._min_spread
+
+    def _set_target(self, spread: float) -> None:
+        self._target_spread = min(self._max_spread, max(self._min_spread, spread))
+
+    def end(self) -> None:
+        """以当前目标位置结束手势"""
+        if not self._active:
+            return
+        self._spread = self._target_spread
+        self._send(AMotionEventAction.MOVE, self._spread, 1.0)
+        self._send(AMotionEventAction.UP, self._spread, 0.0)
+        self._active = False
+        self._sent_spread = -1
+        self._clock.unsubscribe(self._subscription_id)
+        self._subscription_id = None
+
+    def _on_tick(self, now: float) -> bool:
+        if not self._active:
+            self._subscription_id = None
+            return False
+
+        diff = self._target_spread - self._spread
+        if abs(diff) < 0.5:
+            self._spread = self._target_spread
+        else:
+            self._spread += diff * self.SMOOTHING
+        self._send(AMotionEventAction.MOVE, self._spread, 1.0)
+
+        if (
+            not self._from_touchpad
+            and self._spread == self._target_spread
+            and now - self._last_input_time >= self.IDLE_TIMEOUT
+        ):
+            self._subscription_id = None
+            self.end()
+            return False
+        return True
+
+    def _send(self, action: AMotionEventAction, spread: float, pressure: float) -> None:
+        offset = int(spread)
+        if action == AMotionEventAction.MOVE:
+            # 半间距没有变化时不重复发送
+            if offset == self._sent_spread:
+                return
+        self._sent_spread = offset
+
+        w, h = self.screen_info.get_host_resolution()
+        fingers = (
+            (PointerId.GENERIC_FINGER, -offset, offset),
+            (PointerId.VIRTUAL_FINGER, offset, -offset),
+        )
+        for pointer_id, x_offset, y_offset in fingers:
+            msg = InjectTouchEventMsg(
+                action=action,
+                pointer_id=pointer_id,
+                position=(int(self._anchor_x + x_offset), int(self._anchor_y + y_offset), w, h),
+                pressure=pressure,
+                action_button=0,
+                buttons=0,
+            )
+            self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
+
+
+class ScrollPipeline:
+    """
+    滚动事件累积器
+
+    Deltas are accumulated per axis in wheel notches (high resolution wheels
+    report fractions of a notch, i.e. v120 / 120) and flushed at most once
+    per MotionClock tick. The first delta of a burst is flushed right away
+    so a single wheel click has no added latency. Anything that does not fit
+    in one message, or is below the i16 fixed point step, is carried over to
+    the next flush instead of being dropped.
+
+    Optional behaviour, read from the app config when a burst starts:
+        controller.scroll.kinetic: continue touchpad scrolling after the
+            fingers lift, using the velocity from the "decelerate" signal
+        controller.scroll.touch_drag: inject a one-finger drag instead of
+            scroll events, for apps that ignore scroll events
+    """
+
+    KINETIC_CONFIG_KEY = "controller.scroll.kinetic"
+    TOUCH_DRAG_CONFIG_KEY = "controller.scroll.touch_drag"
+
+    # scrcpy 的滚动值 1.0 对应 16 个刻度
+    NOTCHES_PER_UNIT = 16.0
+    FIXED_POINT_STEP = 1.0 / 0x8000
+    # 触控板像素到刻度的换算
+    SURFACE_PIXELS_PER_NOTCH = 12.5
+    # 拖动模式下每个刻度移动的像素
+    DRAG_PIXELS_PER_NOTCH = 40.0
+    DRAG_IDLE_TIMEOUT = 0.15
+    # 惯性滚动的衰减时间常数（秒）和停止速度（刻度/秒）
+    KINETIC_TIME_CONSTANT = 0.325
+    KINETIC_MIN_VELOCITY = 0.5
+
+    def __init__(self, event_bus: EventBus, screen_info: ScreenInfo) -> None:
+        self.event_bus = event_bus
+        self.screen_info = screen_info
+        self._clock = MotionClock()
+        self._config_manager = FileConfigManager()
+        self._subscription_id: int | None = None
+        self.kinetic = False
+        self.touch_drag = False
+        self._pending_h = 0.0
+        self._pending_v = 0.0
+        self._x = 0.0
+        self._y = 0.0
+        self._buttons: AMotionEventButtons | int = 0
+        self._last_input_time = 0.0
+        self._last_tick_time = 0.0
+        self._velocity_h = 0.0
+        self._velocity_v = 0.0
+        self._dragging = False
+        self._drag_x = 0.0
+        self._drag_y = 0.0
+
+    def _load_options(self) -> None:
+        self.kinetic = bool(self._config_manager.get_value(self.KINETIC_CONFIG_KEY, False))
+        self.touch_drag = bool(self._config_manager.get_value(self.TOUCH_DRAG_CONFIG_KEY, False))
+
+    def _is_idle(self) -> bool:
+        return not self._clock.is_subscribed(self._subscription_id)
+
+    def add(
+        self,
+        x: float,
+        y: float,
+        notches_h: float,
+        notches_v: float,
+        buttons: AMotionEventButtons | int,
+    ) -> None:
+        """累积一次滚动，单位为刻度，正值表示向右/向上滚动内容"""
+        burst_start = self._is_idle()
+        if burst_start:
+            self._load_options()
+
+        # 新的输入打断惯性滚动
+        self._velocity_h = 0.0
+        self._velocity_v = 0.0
+        self._pending_h += notches_h
+        self._pending_v += notches_v
+        self._x = x
+        self._y = y
+        self._buttons = buttons
+        self._last_input_time = get_clock().now()
+
+        if burst_start:
+            self._last_tick_time = self._last_input_time
+            self._flush()
+            self._subscription_id = self._clock.subscribe(self._on_tick)
+
+    def decelerate(self, velocity_h: float, velocity_v: float) -> None:
+        """触控板手指离开时的速度，单位为刻度/秒"""
+        if not self.kinetic:
+            return
+        if math.hypot(velocity_h, velocity_v) < self.KINETIC_MIN_VELOCITY:
+            return
+        self._velocity_h = velocity_h
+        self._velocity_v = velocity_v
+        self._last_input_time = get_clock().now()
+        if self._is_idle():
+            self._last_tick_time = self._last_input_time
+            self._subscription_id = self._clock.subscribe(self._on_tick)
+
+    def _on_tick(self, now: float) -> bool:
+        dt = now - self._last_tick_time
+        self._last_tick_time = now
+
+        if self._velocity_h or self._velocity_v:
+            self._pending_h += self._velocity_h * dt
+            self._pending_v += self._velocity_v * dt
+            decay = math.exp(-dt / self.KINETIC_TIME_CONSTANT)
+            self._velocity_h *= decay
+            self._velocity_v *= decay
+            if math.hypot(self._velocity_h, self._velocity_v) < self.KINETIC_MIN_VELOCITY:
+                self._velocity_h = 0.0
+                self._velocity_v = 0.0
+
+        self._flush()
+
+        if self._velocity_h or self._velocity_v or self._has_pending():
+            return True
+        if self._dragging:
+            if now - self._last_input_time < self.DRAG_IDLE_TIMEOUT:
+                return True
+            self._end_drag()
+        self._subscription_id = None
+        return False
+
+    def _has_pending(self) -> bool:
+        if self.touch_drag:
+            threshold = 1.0 / self.DRAG_PIXELS_PER_NOTCH
+        else:
+            threshold = self.FIXED_POINT_STEP * self.NOTCHES_PER_UNIT
+        return abs(self._pending_h) >= threshold or abs(self._pending_v) >= threshold
+
+    def _take(self, pending: float) -> float:
+        """取出一条消息能容纳的量（scrcpy 单位），余量留在累积器中"""
+        value = max(-1.0, min(1.0, pending / self.NOTCHES_PER_UNIT))
+        return int(value * 0x8000) / 0x8000
+
+    def _flush(self) -> None:
+        if self.touch_drag:
+            self._flush_drag()
+            return
+
+        hscroll = self._take(self._pending_h)
+        vscroll = self._take(self._pending_v)
+        if hscroll == 0 and vscroll == 0:
+            return
+        self._pending_h -= hscroll * self.NOTCHES_PER_UNIT
+        self._pending_v -= vscroll * self.NOTCHES_PER_UNIT
+
+        w, h = self.screen_info.get_host_resolution()
+        position = (round(self._x), round(self._y), w, h)
+        msg = InjectScrollEventMsg(position, hscroll, vscroll, self._buttons)
+        self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
+
+    def _flush_drag(self) -> None:
+        dx = int(self._pending_h * self.DRAG_PIXELS_PER_NOTCH)
+        dy = int(self._pending_v * self.DRAG_PIXELS_PER_NOTCH)
+        if dx == 0 and dy == 0:
+            return
+        self._pending_h -= dx / self.DRAG_PIXELS_PER_NOTCH
+        self._pending_v -= dy / self.DRAG_PIXELS_PER_NOTCH
+
+        w, h = self.screen_info.get_host_resolution()
+        if not self._dragging:
+            self._start_drag()
+
+        # 向上滚动内容等于手指向下拖动
+        new_x = self._drag_x + dx
+        new_y = self._drag_y + dy
+        if not (0 <= new_x < w and 0 <= new_y < h):
+            # 手指到达屏幕边缘，抬起后回到光标处继续拖动
+            self._end_drag()
+            self._start_drag()
+            new_x = min(max(self._drag_x + dx, 0), w - 1)
+            new_y = min(max(self._drag_y + dy, 0), h - 1)
+        self._drag_x = new_x
+        self._drag_y = new_y
+        self._send_drag(AMotionEventAction.MOVE, 1.0)
+
+    def _start_drag(self) -> None:
+        self._dragging = True
+        self._drag_x = self._x
+        self._drag_y = self._y
+        self._send_drag(AMotionEventAction.DOWN, 1.0)
+
+    def _end_drag(self) -> None:
+        if not self._dragging:
+            return
+        self._send_drag(AMotionEventAction.UP, 0.0)
+        self._dragging = False
+
+    def _send_drag(self, action: AMotionEventAction, pressure: float) -> None:
+        w, h = self.screen_info.get_host_resolution()
+        msg = InjectTouchEventMsg(
+            action=action,
+            pointer_id=PointerId.SCROLL_FINGER,
+            position=(int(self._drag_x), int(self._drag_y), w, h),
+            pressure=pressure,
+            action_button=0,
+            buttons=0,
+        )
+        self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
+
+
 class MouseDefault(MouseBase):
     def __init__(self, event_bus: EventBus) -> None:
         self.event_bus = event_bus
@@ -72,38 +440,8 @@ class MouseDefault(MouseBase):
         self._current_x: float = 0
         self._current_y: float = 0
         self.screen_info = ScreenInfo()
-        self.zoom_in_init_length = 20
-        self.zoom_out_init_length = 100
-        self._is_zooming = False
-        self._current_zoom_length = -1
-        self._last_range = 1.0
-        self._zoom_timer_id: int | None = None
-        self._zoom_timeout_seconds = 0.25
-
-    def _start_zoom_timer(self) -> None:
-        self._stop_zoom_timer()
-        self._zoom_timer_id = GLib.timeout_add(
-            int(self._zoom_timeout_seconds * 1000),
-            self._on_zoom_timeout
-        )
-
-    def _stop_zoom_timer(self) -> None:
-        if self._zoom_timer_id is not None:
-            GLib.source_remove(self._zoom_timer_id)
-            self._zoom_timer_id = None
-
-    def _on_zoom_timeout(self) -> bool:
-        
-        current_zoom_length = self._current_zoom_length
-        
-        self._is_zooming = False
-        self._current_zoom_length = -1
-        self._last_range = 1.0
-        self._zoom_timer_id = None
-        
-        self._send_dual_finger_events(AMotionEventAction.UP, int(current_zoom_length), 0.0, 0, 0)
-        
-        return False
+        self._pinch = PinchZoomEngine(event_bus, self.screen_info)
+        self._scroll = ScrollPipeline(event_bus, self.screen_info)
 
     def convert_click_action(self, event: Gdk.Event) -> AMotionEventAction:
         if event.get_event_type() == Gdk.EventType.BUTTON_PRESS:
@@ -213,98 +551,56 @@ class MouseDefault(MouseBase):
         if widget is None:
             return False
 
-        w, h = self.screen_info.get_host_resolution()
-
         event = controller.get_current_event()
         if event is None:
             return False
         state = event.get_modifier_state()
 
-        scroll_begin_x = round(self._current_x)
-        scroll_begin_y = round(self._current_y)
-        # ctrl+scroll begin
-
         # ctrl+scroll
         if (state & Gdk.ModifierType.CONTROL_MASK) and dy is not None:
             ctrl_zoom_range = -dy
             return self.zoom_processor(controller, ctrl_zoom_range, None)
-        else:
 
-            position = (scroll_begin_x, scroll_begin_y, w, h)
-            hscroll = dx if dx else 0
-            vscroll = dy if dy else 0
-            if controller.get_unit() == Gdk.ScrollUnit.SURFACE:
-                hscroll = float(hscroll)
-                vscroll = float(vscroll)
-            if hscroll == 0 and vscroll == 0:
-                return False
-            if self.natural_scroll:
-                hscroll = -hscroll
-                vscroll = -vscroll
-            buttons = self.convert_buttons(event)
-
-            if hscroll !=0 and hscroll.is_integer() or vscroll != 0 and vscroll.is_integer():
-                factor = 0.0625
-            else:
-                factor = 0.005
-
-            hscroll_clamped = max(-1.0, min(1.0, hscroll * factor))
-            vscroll_clamped = max(-1.0, min(1.0, vscroll * factor))
-
-            msg = InjectScrollEventMsg(position, hscroll_clamped, vscroll_clamped, buttons)
-            self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
-            return True
+        hscroll = float(dx) if dx else 0.0
+        vscroll = float(dy) if dy else 0.0
+        if hscroll == 0 and vscroll == 0:
+            return False
+        if self.natural_scroll:
+            hscroll = -hscroll
+            vscroll = -vscroll
 
-    def touch_processor(self):
-        return True
+        if self._is_surface_scroll(controller, hscroll, vscroll):
+            hscroll /= ScrollPipeline.SURFACE_PIXELS_PER_NOTCH
+            vscroll /= ScrollPipeline.SURFACE_PIXELS_PER_NOTCH
 
-    def _create_touch_event(
-        self, 
-        action: AMotionEventAction, 
-        pointer_id: PointerId, 
-        x_offset: int, 
-        y_offset: int, 
-        pressure: float = 1.0,
-        action_button: int = 0,
-        buttons: int = 0
-    ) -> InjectTouchEventMsg:
-        w, h = self.screen_info.get_host_resolution()
-        return InjectTouchEventMsg(
-            action=action,
-            pointer_id=pointer_id,
-            position=(int(self._current_x + x_offset), int(self._current_y + y_offset), w, h),
-            pressure=pressure,
-            action_button=action_button,
-            buttons=buttons,
-        )
-
-    def _send_dual_finger_events(
-        self, 
-        action: AMotionEventAction, 
-        zoom_length: int, 
-        pressure: float = 1.0,
-        action_button: int = 0,
-        buttons: int = 0
-    ) -> None:
-        msg1 = self._create_touch_event(
-            action, PointerId.GENERIC_FINGER, -zoom_length, zoom_length, pressure, action_button, buttons
-        )
-        msg2 = self._create_touch_event(
-            action, PointerId.VIRTUAL_FINGER, zoom_length, -zoom_length, pressure, action_button, buttons
-        )
-        self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg1))
-        self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg2))
+        buttons = self.convert_buttons(event)
+        self._scroll.add(self._current_x, self._current_y, hscroll, vscroll, buttons)
+        return True
 
-    def _handle_zoom_length_reset(self, new_zoom_length: float) -> float:
-        if new_zoom_length > self.zoom_out_init_length:
-            return self.zoom_in_init_length
-        elif new_zoom_length < self.zoom_in_init_length:
-            return self.zoom_out_init_length
-        return new_zoom_length
+    def _is_surface_scroll(
+        self, controller: "Gtk.EventControllerScroll", hscroll: float, vscroll: float
+    ) -> bool:
+        """触控板等平滑滚动以像素为单位，滚轮（包括高精度滚轮）以刻度为单位"""
+        if hasattr(controller, "get_unit"):
+            return controller.get_unit() == Gdk.ScrollUnit.SURFACE
+        # GTK < 4.8 没有 get_unit，按旧的方式猜测
+        return not (hscroll.is_integer() and vscroll.is_integer())
+
+    def scroll_decelerate_processor(
+        self, controller: "Gtk.EventControllerScroll", vel_x: float, vel_y: float
+    ) -> bool:
+        """触控板滚动结束时的速度（像素/秒）"""
+        if self.natural_scroll:
+            vel_x = -vel_x
+            vel_y = -vel_y
+        if self._is_surface_scroll(controller, vel_x, vel_y):
+            vel_x /= ScrollPipeline.SURFACE_PIXELS_PER_NOTCH
+            vel_y /= ScrollPipeline.SURFACE_PIXELS_PER_NOTCH
+        self._scroll.decelerate(vel_x, vel_y)
+        return True
 
-    def _reset_zoom_fingers(self, old_length: float, new_length: float, action_button: int = 0, buttons: int = 0) -> None:
-        self._send_dual_finger_events(AMotionEventAction.UP, int(old_length), 0.0, action_button, buttons)
-        self._send_dual_finger_events(AMotionEventAction.DOWN, int(new_length), 1.0, action_button, buttons)
+    def touch_processor(self):
+        return True
 
     def zoom_processor(
         self, controller, range: float, status:str|None
@@ -312,64 +608,17 @@ class MouseDefault(MouseBase):
         event = controller.get_current_event()
         if event is None:
             return False
-        
-        action_button = 0
-        buttons = 0
-        
-        if event.get_event_type() != Gdk.EventType.TOUCHPAD_PINCH:
-            buttons = self.convert_buttons(event)
-        
+
         if event.get_event_type() == Gdk.EventType.TOUCHPAD_PINCH:
             if status == "begin":
-                self._is_zooming = True
+                self._pinch.pinch_begin()
             elif status == "scale-changed":
-                if self._current_zoom_length == -1:
-                    self._current_zoom_length = self.zoom_in_init_length if range > 1 else self.zoom_out_init_length
-                    self._send_dual_finger_events(AMotionEventAction.DOWN, int(self._current_zoom_length), 1.0, action_button, buttons)
-                
-                old_zoom_length = self._current_zoom_length
-                new_zoom_length = self._current_zoom_length + (self.zoom_in_init_length + self.zoom_out_init_length) * (range - self._last_range)
-                final_zoom_length = self._handle_zoom_length_reset(new_zoom_length)
-                
-                if final_zoom_length != new_zoom_length:
-                    self._reset_zoom_fingers(old_zoom_length, final_zoom_length, action_button, buttons)
-                
-                self._current_zoom_length = final_zoom_length
-                self._send_dual_finger_events(AMotionEventAction.MOVE, int(self._current_zoom_length), 1.0, action_button, buttons)
-                self._last_range = range
+                self._pinch.pinch_scale(self._current_x, self._current_y, range)
             elif status == "end":
-                current_zoom_length = self._current_zoom_length
-                self._is_zooming = False
-                self._current_zoom_length = -1
-                self._last_range = 1.0 
-                self._send_dual_finger_events(AMotionEventAction.UP, int(current_zoom_length), 0.0, action_button, buttons)
+                self._pinch.end()
         else:
-            # ctrl+scroll 
-            if not self._is_zooming:
-                # 开始新的缩放，启动计时器
-                self._is_zooming = True
-                self._current_zoom_length = self.zoom_in_init_length if range > 0 else self.zoom_out_init_length
-                self._start_zoom_timer()
-                self._send_dual_finger_events(AMotionEventAction.DOWN, int(self._current_zoom_length), 1.0, action_button, buttons)
-            else:
-                # 正在缩放中，刷新计时器
-                self._start_zoom_timer()
-
-
-            if abs(range) == 1:
-                range *= 0.1
-            else:
-                range *= 0.01
-
-            old_zoom_length = self._current_zoom_length
-            new_zoom_length = self._current_zoom_length + (self.zoom_in_init_length + self.zoom_out_init_length) * range
-            
-            final_zoom_length = self._handle_zoom_length_reset(new_zoom_length)
-            
-            if final_zoom_length != new_zoom_length:
-                self._reset_zoom_fingers(old_zoom_length, final_zoom_length, action_button, buttons)
-
-            self._current_zoom_length = final_zoom_length
-            self._send_dual_finger_events(AMotionEventAction.MOVE, int(self._current_zoom_length), 1.0, action_button, buttons)
+            # ctrl+scroll，离散滚轮一格为 1，平滑滚动的增量约大十倍
+            notches = range if abs(range) == 1 else range * 0.1
+            self._pinch.wheel(self._current_x, self._current_y, notches)
 
         return True
@@ -10,6 +10,7 @@ from enum import IntEnum
 from typing import Any
 
 from waydroid_helper.controller.core.key_system import Key
+from waydroid_helper.util.idle import IdleMonitor
 from waydroid_helper.util.log import logger
 
 
@@ -87,6 +88,8 @@ class InputEventHandlerChain:
         if not self.enabled:
             return False
 
+        IdleMonitor().notify_activity()
+
         for handler in self.handlers:
             if not handler.enabled:
                 continue
@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+"""
+注入写线程
+独占控制 socket 的写端，由 GTK 线程通过无锁环形队列投递消息
+"""
+
+import os
+import socket
+import threading
+import time
+
+from waydroid_helper.util.log import logger
+
+
+class SpscRing:
+    """
+    预分配的单生产者单消费者环形队列
+
+    Only the producer moves the tail and only the consumer moves the head,
+    so with the GIL no lock is needed. Slots are allocated once.
+    """
+
+    def __init__(self, capacity: int = 4096):
+        # 容量取 2 的幂，用位与代替取模
+        capacity = 1 << max(1, (capacity - 1).bit_length())
+        self.capacity: int = capacity
+        self._mask: int = capacity - 1
+        self._data: list[bytes | None] = [None] * capacity
+        self._times: list[float] = [0.0] * capacity
+        self._head: int = 0
+        self._tail: int = 0
+
+    def push(self, data: bytes, timestamp: float) -> bool:
+        tail = self._tail
+        if tail - self._head >= self.capacity:
+            return False
+        index = tail & self._mask
+        self._data[index] = data
+        self._times[index] = timestamp
+        self._tail = tail + 1
+        return True
+
+    def pop(self) -> tuple[bytes, float] | None:
+        head = self._head
+        if head == self._tail:
+            return None
+        index = head & self._mask
+        data = self._data[index]
+        self._data[index] = None
+        self._head = head + 1
+        return data, self._times[index]  # type: ignore[return-value]
+
+    def __len__(self) -> int:
+        return self._tail - self._head
+
+
+class InjectionWriter:
+    """
+    控制 socket 写线程
+
+    Scheduling is raised as far as the process is allowed: SCHED_FIFO
+    first, then a negative nice value, otherwise the thread keeps the
+    default policy and only logs why. The delay between push() and the
+    write is tracked so the effect can be checked in the log.
+
+    attach() and detach() may race with the writer dropping a broken
+    connection, so the socket is swapped under _lock. Messages pushed
+    before the current attach() are discarded, not replayed to the new
+    connection.
+    """
+
+    FIFO_PRIORITY = 10
+    NICE_VALUE = -10
+    STATS_INTERVAL = 10.0
+    # 未连接时等待的上限，超时后重新检查是否已停止
+    IDLE_WAIT = 0.5
+
+    def __init__(
+        self,
+        capacity: int = 4096,
+        realtime: bool = True,
+        cpu: int | None = None,
+    ):
+        self.ring = SpscRing(capacity)
+        self.realtime: bool = realtime
+        self.cpu: int | None = cpu
+        self.policy: str = "default"
+        self.dropped: int = 0
+
+        self._sock: socket.socket | None = None
+        self._lock = threading.Lock()
+        self._attached = threading.Event()
+        # 当前连接建立的时间，之前投递的消息不再发送
+        self._attached_at: float = 0.0
+        self.stale: int = 0
+        self._wakeup_fd: int = os.eventfd(0, os.EFD_CLOEXEC)
+        self._waiting: bool = False
+        self._running: bool = False
+        self._thread: threading.Thread | None = None
+
+        self._latency_count: int = 0
+        self._latency_sum: float = 0.0
+        self._latency_max: float = 0.0
+        self._stats_time: float = time.monotonic()
+
+    def start(self) -> None:
+        if self._running:
+            return
+        self._running = True
+        self._thread = threading.Thread(
+            target=self._run, name="mapper-writer", daemon=True
+        )
+        self._thread.start()
+
+    def stop(self) -> None:
+        # 先断开 socket，阻塞在 sendall 里的写线程会立即出错返回；
+        # 之后再停止并唤醒，detach() 清掉的 _attached 不会再把它挡住
+        self.detach()
+        self._running = False
+        self._attached.set()
+        os.eventfd_write(self._wakeup_fd, 1)
+        if self._thread is not None:
+            self._thread.join()
+            self._thread = None
+        os.close(self._wakeup_fd)
+
+    def attach(self, sock: socket.socket) -> None:
+        """开始向新连接写入，sock 必须是阻塞模式且归本对象所有"""
+        with self._lock:
+            old, self._sock = self._sock, sock
+            self._attached_at = time.perf_counter()
+            self._attached.set()
+        self._close(old)
+        os.eventfd_write(self._wakeup_fd, 1)
+
+    def detach(self, sock: socket.socket | None = None) -> None:
+        """断开当前连接；给出 sock 时只在它仍是当前连接时断开"""
+        with self._lock:
+            if sock is not None and sock is not self._sock:
+                return
+            old, self._sock = self._sock, None
+            self._attached.clear()
+        self._close(old)
+
+    @staticmethod
+    def _close(sock: socket.socket | None) -> None:
+        if sock is not None:
+            # 只 close 不会打断另一个线程里正在阻塞的 sendall，shutdown 会
+            try:
+                sock.shutdown(socket.SHUT_RDWR)
+            except OSError:
+                pass
+            try:
+                sock.close()
+            except OSError:
+                pass
+
+    def push(self, data: bytes) -> bool:
+        """投递一条消息，只能在生产者线程调用"""
+        if not self.ring.push(data, time.perf_counter()):
+            self.dropped += 1
+            if self.dropped == 1 or self.dropped % 1000 == 0:
+                logger.warning(f"Injection ring full, dropped {self.dropped} messages")
+            return False
+        if self._waiting:
+            os.eventfd_write(self._wakeup_fd, 1)
+        return True
+
+    def _apply_scheduling(self) -> None:
+        if self.cpu is not None:
+            try:
+                os.sched_setaffinity(0, {self.cpu})
+                logger.info(f"Injection writer pinned to CPU {self.cpu}")
+            except (OSError, ValueError) as e:
+                logger.warning(f"Cannot pin injection writer to CPU {self.cpu}: {e}")
+
+        if not self.realtime:
+            return
+        try:
+            os.sched_setscheduler(0, os.SCHED_FIFO, os.sched_param(self.FIFO_PRIORITY))
+            self.policy = f"SCHED_FIFO:{self.FIFO_PRIORITY}"
+        except (OSError, AttributeError):
+            try:
+                os.setpriority(os.PRIO_PROCESS, threading.get_native_id(), self.NICE_VALUE)
+                self.policy = f"nice:{self.NICE_VALUE}"
+            except OSError:
+                logger.info("No permission to raise injection writer priority, using default scheduling")
+        logger.info(f"Injection writer scheduling policy: {self.policy}")
+
+    def _wait_for_data(self) -> None:
+        self._waiting = True
+        # 设置标志后再检查一次，避免错过生产者的唤醒
+        if len(self.ring) == 0 and self._running:
+            os.eventfd_read(self._wakeup_fd)
+        self._waiting = False
+
+    def _run(self) -> None:
+        self._apply_scheduling()
+        while self._running:
+            if not self._attached.is_set():
+                self._attached.wait(self.IDLE_WAIT)
+                continue
+
+            item = self.ring.pop()
+            if item is None:
+                self._wait_for_data()
+                continue
+
+            data, pushed_at = item
+            with self._lock:
+                sock = self._sock
+                attached_at = self._attached_at
+            if sock is None:
+                continue
+            if pushed_at < attached_at:
+                # 断开期间积压的消息，对新连接已经没有意义
+                self.stale += 1
+                continue
+            self._record_latency(time.perf_counter() - pushed_at)
+            try:
+                sock.sendall(data)
+            except OSError as e:
+                logger.info(f"Injection writer connection closed: {e}")
+                self.detach(sock)
+
+    def _record_latency(self, latency: float) -> None:
+        self._latency_count += 1
+        self._latency_sum += latency
+        if latency > self._latency_max:
+            self._latency_max = latency
+
+        now = time.monotonic()
+        if now - self._stats_time >= self.STATS_INTERVAL:
+            logger.debug(
+                f"Injection writer latency over {self._latency_count} messages: "
+                f"avg {self._latency_sum / self._latency_count * 1e6:.0f}us, "
+                f"max {self._latency_max * 1e6:.0f}us ({self.policy})"
+            )
+            self._latency_count = 0
+            self._latency_sum = 0.0
+            self._latency_max = 0.0
+            self._stats_time = now
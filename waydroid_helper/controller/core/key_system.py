@@ -11,7 +11,9 @@ from enum import Enum
 import gi
 
 gi.require_version("Gdk", "4.0")
-from gi.repository import Gdk
+from gi.repository import Gdk, GObject
+
+from waydroid_helper.util.log import logger
 
 
 class KeyType(Enum):
@@ -46,6 +48,8 @@ class KeyRegistry:
     def __init__(self):
         self._keys: dict[int, Key] = {}  # keyval -> Key
         self._names: dict[str, Key] = {}  # name -> Key
+        # 动态创建过的按键，同一个 keyval 只创建一次
+        self._created: dict[int, Key] = {}
         self._init_standard_keys()
 
 
@@ -126,18 +130,21 @@ class KeyRegistry:
     def create_from_keyval(self, keyval: int, state: int = 0) -> Key | None:
         """从keyval和state创建按键（支持动态创建）"""
         # 先尝试从注册表获取
-        key = self.get_by_keyval(keyval)
+        key = self._keys.get(keyval) or self._created.get(keyval)
         if key:
             return key
 
         # 处理可打印字符
         if 32 <= keyval <= 126:
             char = chr(keyval).upper()
-            return Key(char, keyval, KeyType.CHARACTER)
+            key = Key(char, keyval, KeyType.CHARACTER)
+        else:
+            # 处理未知按键
+            key_name = Gdk.keyval_name(keyval) or f"Key{keyval}"
+            key = Key(key_name, keyval, KeyType.SPECIAL)
 
-        # 处理未知按键
-        key_name = Gdk.keyval_name(keyval) or f"Key{keyval}"
-        return Key(key_name, keyval, KeyType.SPECIAL)
+        self._created[keyval] = key
+        return key
 
     def create_mouse_key(self, button: int) -> Key:
         """创建鼠标按键"""
@@ -209,6 +216,105 @@ class KeyRegistry:
             )
         return key_created
 
+class KeycodeTable:
+    """
+    硬件键码 -> 按键 查找表
+
+    Every keycode is translated once per keymap at layout group 0 with no
+    modifiers, upper-cased and resolved through the registry, so a key
+    press is a single list lookup. Because group 0 is used, bindings stay
+    on the same physical keys when the user switches keyboard layouts.
+
+    The table is rebuilt when the keyboard's layouts change and when a
+    device is added to or removed from the seat (a new keyboard may bring
+    its own keymap).
+    """
+
+    # X11/XKB 键码范围
+    MIN_KEYCODE = 8
+    MAX_KEYCODE = 255
+
+    def __init__(self, registry: KeyRegistry, display: Gdk.Display | None = None):
+        self._registry = registry
+        self._display: Gdk.Display | None = None
+        self._keyvals: list[int] = [0] * (self.MAX_KEYCODE + 1)
+        self._keys: list[Key | None] = [None] * (self.MAX_KEYCODE + 1)
+        self._handlers: list[tuple[GObject.Object, int]] = []
+        if display is not None:
+            self.attach(display)
+
+    def attach(self, display: Gdk.Display) -> None:
+        """绑定到 display，监听键盘布局变化并构建查找表"""
+        self.detach()
+        self._display = display
+        seat = display.get_default_seat()
+        if seat is not None:
+            self._handlers.append((seat, seat.connect("device-added", self._on_seat_changed)))
+            self._handlers.append((seat, seat.connect("device-removed", self._on_seat_changed)))
+            keyboard = seat.get_keyboard()
+            if keyboard is not None:
+                self._handlers.append((keyboard, keyboard.connect("changed", self._on_keymap_changed)))
+                try:
+                    # layout-names 需要 GTK 4.10
+                    self._handlers.append(
+                        (keyboard, keyboard.connect("notify::layout-names", self._on_keymap_changed))
+                    )
+                except TypeError:
+                    pass
+        self.rebuild()
+
+    def detach(self) -> None:
+        for obj, handler_id in self._handlers:
+            try:
+                obj.disconnect(handler_id)
+            except Exception:
+                pass
+        self._handlers.clear()
+        self._display = None
+
+    def _on_seat_changed(self, _seat: Gdk.Seat, _device: Gdk.Device) -> None:
+        # 键盘设备可能已更换，重新连接信号
+        if self._display is not None:
+            self.attach(self._display)
+
+    def _on_keymap_changed(self, *_args: object) -> None:
+        self.rebuild()
+
+    def rebuild(self) -> None:
+        keyvals = [0] * (self.MAX_KEYCODE + 1)
+        keys: list[Key | None] = [None] * (self.MAX_KEYCODE + 1)
+        display = self._display
+        if display is not None:
+            for keycode in range(self.MIN_KEYCODE, self.MAX_KEYCODE + 1):
+                try:
+                    success, keyval, _, _, _ = display.translate_key(
+                        keycode=keycode, state=Gdk.ModifierType(0), group=0
+                    )
+                except Exception as e:
+                    logger.error(f"Failed to translate keycode {keycode}: {e}")
+                    break
+                if not success or keyval == 0:
+                    continue
+                keyval = Gdk.keyval_to_upper(keyval)
+                keyvals[keycode] = keyval
+                keys[keycode] = self._registry.create_from_keyval(keyval)
+        self._keyvals = keyvals
+        self._keys = keys
+        logger.debug(f"Keycode table rebuilt: {sum(1 for k in keys if k is not None)} keys")
+
+    def keyval(self, keycode: int) -> int:
+        """键码对应的标准 keyval，未知时返回 0"""
+        if 0 <= keycode <= self.MAX_KEYCODE:
+            return self._keyvals[keycode]
+        return 0
+
+    def lookup(self, keycode: int) -> Key | None:
+        """键码对应的按键，未知时返回 None"""
+        if 0 <= keycode <= self.MAX_KEYCODE:
+            return self._keys[keycode]
+        return None
+
+
 @dataclass(frozen=True)
 class KeyCombination:
     """按键组合 - 不可变、可哈希、可排序"""
@@ -0,0 +1,328 @@
+#!/usr/bin/env python3
+"""
+控制通道往返延迟
+定期发送 GET_CLIPBOARD 探测，并统计能和请求对上的设备回复（探测回复、剪贴板 ACK）所需的时间
+"""
+
+import bisect
+from collections import deque
+from typing import Any, Callable
+
+from waydroid_helper.config.file_manager import ConfigManager as FileConfigManager
+from waydroid_helper.controller.core.clock import get_clock
+from waydroid_helper.controller.core.control_msg import GetClipboardMsg
+from waydroid_helper.controller.core.device_msg import (
+    AckClipboardDeviceMsg,
+    ClipboardDeviceMsg,
+)
+from waydroid_helper.controller.core.event_bus import Event, EventBus, EventType
+from waydroid_helper.util.idle import IdleMonitor
+from waydroid_helper.util.log import logger
+
+
+class LatencyHistogram:
+    """
+    最近的延迟分布（毫秒）
+
+    Keeps at most window samples, none older than max_age seconds, in
+    arrival order and in a sorted list next to it, so percentiles are a
+    lookup. Call expire() with the current time before reading.
+    """
+
+    BUCKETS_MS = (1, 2, 5, 10, 20, 50, 100, 200, 500, 1000)
+
+    def __init__(self, window: int = 256, max_age: float = 30.0):
+        self.window: int = window
+        self.max_age: float = max_age
+        # (时间, 延迟)，按到达顺序
+        self._samples: deque[tuple[float, float]] = deque()
+        self._sorted: list[float] = []
+
+    def __len__(self) -> int:
+        return len(self._samples)
+
+    def add(self, latency_ms: float, now: float) -> None:
+        self._samples.append((now, latency_ms))
+        bisect.insort(self._sorted, latency_ms)
+        if len(self._samples) > self.window:
+            self._drop_oldest()
+
+    def expire(self, now: float) -> None:
+        while self._samples and now - self._samples[0][0] > self.max_age:
+            self._drop_oldest()
+
+    def _drop_oldest(self) -> None:
+        _, latency_ms = self._samples.popleft()
+        del self._sorted[bisect.bisect_left(self._sorted, latency_ms)]
+
+    def percentile(self, p: float) -> float | None:
+        if not self._sorted:
+            return None
+        index = min(len(self._sorted) - 1, max(0, round(p / 100 * (len(self._sorted) - 1))))
+        return self._sorted[index]
+
+    def recent(self, since: float) -> list[float]:
+        """since 之后到达的样本，按到达顺序"""
+        samples: list[float] = []
+        for at, latency_ms in reversed(self._samples):
+            if at < since:
+                break
+            samples.append(latency_ms)
+        samples.reverse()
+        return samples
+
+    def buckets(self) -> list[tuple[str, int]]:
+        """每个区间的样本数，区间上限含在内，最后一个区间没有上限"""
+        counts: list[int] = []
+        start = 0
+        for bound in self.BUCKETS_MS:
+            end = bisect.bisect_right(self._sorted, bound)
+            counts.append(end - start)
+            start = end
+        counts.append(len(self._sorted) - start)
+        labels = [f"<={bound}ms" for bound in self.BUCKETS_MS] + [f">{self.BUCKETS_MS[-1]}ms"]
+        return list(zip(labels, counts))
+
+    def summary(self) -> str:
+        if not self._sorted:
+            return "no samples"
+        p50, p95, p99 = (self.percentile(p) for p in (50, 95, 99))
+        return (
+            f"p50 {p50:.1f}ms, p95 {p95:.1f}ms, p99 {p99:.1f}ms, "
+            f"max {self._sorted[-1]:.1f}ms, n={len(self._sorted)}"
+        )
+
+
+# 正在运行的探测器，供不持有它的组件读取测量值
+_running_probe: "LatencyProbe | None" = None
+
+
+def measured_rtt_ms() -> float | None:
+    """当前连接的往返延迟中位数（毫秒），没有新近的测量值时返回 None"""
+    if _running_probe is None:
+        return None
+    return _running_probe.median_ms()
+
+
+class LatencyProbe:
+    """
+    控制通道往返延迟探测
+
+    Only replies that can be matched to their request are timed, and only
+    small ones: a reply or request carrying more than MAX_SAMPLE_PAYLOAD
+    bytes of clipboard text measures the transfer, not the channel, and is
+    not recorded.
+
+    Active (on by default): every interval seconds one GET_CLIPBOARD (copy
+    key NONE, so nothing is copied on the device) is sent and the next
+    CLIPBOARD device message is timed as its reply. AdbHelper starts
+    scrcpy-server with clipboard_autosync=false, so the server answers
+    every GET_CLIPBOARD and sends no other CLIPBOARD messages; the reply is
+    also how ClipboardSync learns about device clipboard changes. The
+    server does not answer while the device clipboard is empty, so an
+    unanswered probe only counts as a stall once a probe has been answered
+    on this connection.
+
+    Passive: every SET_CLIPBOARD that ClipboardSync sends carries a
+    sequence number, and the device answers it with an ACK_CLIPBOARD
+    carrying the same number. ClipboardSync reports each send through
+    track(); the matching ACK gives one sample.
+
+    A request older than TIMEOUT counts as a stall (stall_ms()); after
+    LOST_AFTER it is dropped and counted as lost. Samples older than
+    SAMPLE_MAX_AGE no longer count for median_ms(). A sample above
+    SPIKE_FACTOR times the rolling median (and at least SPIKE_MIN_MS) logs
+    a warning. With "log" enabled the histogram summary is logged every
+    LOG_EVERY samples for benchmark runs.
+
+    Config (config.json):
+        controller.rtt_probe.enabled: bool, default true
+        controller.rtt_probe.active: bool, default true; turning it off also
+            stops device -> host clipboard sync
+        controller.rtt_probe.interval: seconds between active probes, default 2
+        controller.rtt_probe.log: bool, default false
+    """
+
+    CONFIG_KEY = "controller.rtt_probe"
+    DEFAULT_INTERVAL = 2.0
+    TIMEOUT = 2.0
+    LOST_AFTER = 10.0
+    SAMPLE_MAX_AGE = 30.0
+    MAX_SAMPLE_PAYLOAD = 4096
+    SPIKE_FACTOR = 4.0
+    SPIKE_MIN_MS = 50.0
+    # 至少有这么多样本后才判断尖峰
+    SPIKE_MIN_SAMPLES = 10
+    LOG_EVERY = 12
+    # 主动探测在 _pending 里的键；被动请求用剪贴板序号，从 1 开始
+    ACTIVE_KEY = 0
+
+    def __init__(
+        self,
+        event_bus: EventBus,
+        is_connected: Callable[[], bool] | None = None,
+    ):
+        self.event_bus = event_bus
+        self.is_connected = is_connected
+        self.histogram = LatencyHistogram(max_age=self.SAMPLE_MAX_AGE)
+        self.sent: int = 0
+        self.lost: int = 0
+        self.last_ms: float | None = None
+        # 请求键 -> 发送时间
+        self._pending: dict[int, float] = {}
+        # 本次连接是否收到过探测回复；设备剪贴板为空时服务端不回复
+        self._active_answered: bool = False
+        self._started: bool = False
+        self._source_id: int | None = None
+        self._idle_id: int | None = None
+
+        options = FileConfigManager().get_value(self.CONFIG_KEY, {})
+        if not isinstance(options, dict):
+            options = {}
+        self.enabled = bool(options.get("enabled", True))
+        self.active = bool(options.get("active", True))
+        self.log_samples = bool(options.get("log", False))
+        try:
+            self.interval = max(0.5, float(options.get("interval", self.DEFAULT_INTERVAL)))
+        except (TypeError, ValueError):
+            self.interval = self.DEFAULT_INTERVAL
+
+    def start(self) -> None:
+        global _running_probe
+        if not self.enabled or self._started:
+            return
+        self._started = True
+        _running_probe = self
+        self.event_bus.subscribe(EventType.DEVICE_MSG, self._on_device_msg, subscriber=self)
+        if self.active:
+            # 空闲模式下不探测
+            self._idle_id = IdleMonitor().register(on_idle=self._stop_timer, on_active=self._start_timer)
+            self._start_timer()
+
+    def stop(self) -> None:
+        global _running_probe
+        self._stop_timer()
+        IdleMonitor().unregister(self._idle_id)
+        self._idle_id = None
+        if self._started:
+            self.event_bus.unsubscribe_by_subscriber(self)
+            self._started = False
+        if _running_probe is self:
+            _running_probe = None
+        self._pending.clear()
+        if self.log_samples and len(self.histogram):
+            logger.info(f"Control RTT: {self.histogram.summary()}, sent {self.sent}, lost {self.lost}")
+
+    def _start_timer(self) -> None:
+        if self.active and self._source_id is None:
+            self._source_id = get_clock().timeout_add(int(self.interval * 1000), self._tick)
+
+    def _stop_timer(self) -> None:
+        if self._source_id is not None:
+            get_clock().source_remove(self._source_id)
+            self._source_id = None
+
+    def track(self, sequence: int, payload_size: int = 0) -> None:
+        """ClipboardSync 发出带序号的 SET_CLIPBOARD 时调用"""
+        if not self._started or sequence <= 0 or payload_size > self.MAX_SAMPLE_PAYLOAD:
+            return
+        now = get_clock().now()
+        self._expire(now)
+        self.sent += 1
+        self._pending[sequence] = now
+
+    def _tick(self) -> bool:
+        now = get_clock().now()
+        self._expire(now)
+        if self.ACTIVE_KEY in self._pending:
+            return True
+        if self.is_connected is not None and not self.is_connected():
+            self._active_answered = False
+            return True
+        self.sent += 1
+        self._pending[self.ACTIVE_KEY] = now
+        self.event_bus.emit(Event(EventType.CONTROL_MSG, self, GetClipboardMsg()))
+        return True
+
+    def _expire(self, now: float) -> None:
+        for key, sent_at in list(self._pending.items()):
+            if now - sent_at < self.LOST_AFTER:
+                continue
+            del self._pending[key]
+            if key == self.ACTIVE_KEY and not self._active_answered:
+                # 设备剪贴板为空，不算丢失
+                self.sent -= 1
+                continue
+            self.lost += 1
+            source = "GET_CLIPBOARD probe" if key == self.ACTIVE_KEY else f"Clipboard seq {key}"
+            logger.warning(f"{source} got no reply within {self.LOST_AFTER:.0f}s")
+
+    def outstanding_ms(self) -> float:
+        """最早一个还在等待回复的请求已经等了多久，没有时返回 0"""
+        pending = [
+            sent_at
+            for key, sent_at in self._pending.items()
+            if key != self.ACTIVE_KEY or self._active_answered
+        ]
+        if not pending:
+            return 0.0
+        return (get_clock().now() - min(pending)) * 1000
+
+    def stall_ms(self) -> float:
+        """等待超过 TIMEOUT 但还没算作丢失的请求的等待时间，没有时返回 0"""
+        self._expire(get_clock().now())
+        outstanding = self.outstanding_ms()
+        return outstanding if outstanding >= self.TIMEOUT * 1000 else 0.0
+
+    def median_ms(self, max_age: float | None = None, min_samples: int = 1) -> float | None:
+        """
+        最近样本的中位数
+
+        Uses the samples of the last max_age seconds (SAMPLE_MAX_AGE by
+        default) and returns None when there are fewer than min_samples.
+        """
+        now = get_clock().now()
+        self.histogram.expire(now)
+        if max_age is None:
+            if len(self.histogram) < max(1, min_samples):
+                return None
+            return self.histogram.percentile(50)
+        samples = sorted(self.histogram.recent(now - max_age))
+        if len(samples) < max(1, min_samples):
+            return None
+        return samples[round((len(samples) - 1) / 2)]
+
+    def _on_device_msg(self, event: Event[Any]) -> None:
+        msg = event.data
+        if isinstance(msg, AckClipboardDeviceMsg):
+            key = msg.sequence
+        elif isinstance(msg, ClipboardDeviceMsg):
+            # 只是观察，消息照常交给 ClipboardSync
+            key = self.ACTIVE_KEY
+        else:
+            return
+        sent_at = self._pending.pop(key, None)
+        if sent_at is None:
+            return
+        if key == self.ACTIVE_KEY:
+            self._active_answered = True
+            if len(msg.text.encode("utf-8")) > self.MAX_SAMPLE_PAYLOAD:
+                # 回复时间主要是传输大段文本的时间
+                return
+        self._record(key, (get_clock().now() - sent_at) * 1000)
+
+    def _record(self, key: int, latency_ms: float) -> None:
+        median = self.median_ms()
+        if (
+            median is not None
+            and len(self.histogram) >= self.SPIKE_MIN_SAMPLES
+            and latency_ms >= max(self.SPIKE_MIN_MS, median * self.SPIKE_FACTOR)
+        ):
+            source = "GET_CLIPBOARD probe" if key == self.ACTIVE_KEY else f"clipboard seq {key}"
+            logger.warning(
+                f"Control RTT spike: {source} took {latency_ms:.1f}ms (median {median:.1f}ms)"
+            )
+        self.histogram.add(latency_ms, get_clock().now())
+        self.last_ms = latency_ms
+        if self.log_samples and len(self.histogram) % self.LOG_EVERY == 0:
+            logger.info(f"Control RTT: {self.histogram.summary()}, sent {self.sent}, lost {self.lost}")
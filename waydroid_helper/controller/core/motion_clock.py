@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""
+共享输出节拍
+所有需要按固定频率输出运动事件的组件共用一个定时器
+"""
+
+from typing import Callable
+
+from waydroid_helper.controller.core.clock import Clock, get_clock
+from waydroid_helper.util.log import logger
+
+# 回调参数为当前时钟的 now()，返回 False 表示取消订阅
+TickCallback = Callable[[float], bool]
+
+
+class MotionClock:
+    """
+    运动输出时钟 (单例)
+
+    Subscribers are called once per tick in subscription order. The timer
+    only exists while there is at least one subscriber, so an idle mapper
+    does not wake up. The timer is taken from the global clock when it is
+    started, so a simulation drives the ticks in virtual time.
+    """
+
+    DEFAULT_INTERVAL_MS = 16
+    MIN_INTERVAL_MS = 4
+    MAX_INTERVAL_MS = 100
+
+    _instance: "MotionClock | None" = None
+
+    def __new__(cls):
+        if cls._instance is None:
+            cls._instance = super().__new__(cls)
+            cls._instance._initialized = False
+        return cls._instance
+
+    def __init__(self):
+        if self._initialized:
+            return
+        self._initialized: bool = True
+
+        self._interval_ms: int = self.DEFAULT_INTERVAL_MS
+        self._subscribers: dict[int, TickCallback] = {}
+        self._next_id: int = 1
+        self._source_id: int | None = None
+        self._source_clock: Clock | None = None
+        self._source_interval_ms: int = self._interval_ms
+        self._dispatching: bool = False
+
+    @property
+    def interval_ms(self) -> int:
+        return self._interval_ms
+
+    def set_interval_ms(self, interval_ms: int) -> None:
+        """修改节拍间隔，正在运行的定时器会按新间隔重启"""
+        interval_ms = max(self.MIN_INTERVAL_MS, min(self.MAX_INTERVAL_MS, int(interval_ms)))
+        if interval_ms == self._interval_ms:
+            return
+        self._interval_ms = interval_ms
+        if self._source_id is not None and not self._dispatching:
+            self._stop()
+            self._start()
+
+    def subscribe(self, callback: TickCallback) -> int:
+        """订阅节拍，返回订阅 ID"""
+        subscription_id = self._next_id
+        self._next_id += 1
+        self._subscribers[subscription_id] = callback
+        self._start()
+        return subscription_id
+
+    def unsubscribe(self, subscription_id: int | None) -> None:
+        if subscription_id is None:
+            return
+        self._subscribers.pop(subscription_id, None)
+        if not self._subscribers and not self._dispatching:
+            self._stop()
+
+    def is_subscribed(self, subscription_id: int | None) -> bool:
+        return subscription_id is not None and subscription_id in self._subscribers
+
+    def _start(self) -> None:
+        # 分发过程中由 _on_tick 的返回值决定定时器是否继续
+        if self._dispatching:
+            return
+        if self._source_id is None and self._subscribers:
+            self._source_interval_ms = self._interval_ms
+            self._source_clock = get_clock()
+            self._source_id = self._source_clock.timeout_add(self._interval_ms, self._on_tick)
+
+    def _stop(self) -> None:
+        if self._source_id is not None and self._source_clock is not None:
+            self._source_clock.source_remove(self._source_id)
+        self._source_id = None
+
+    def _on_tick(self) -> bool:
+        assert self._source_clock is not None
+        now = self._source_clock.now()
+        self._dispatching = True
+        try:
+            for subscription_id, callback in list(self._subscribers.items()):
+                try:
+                    keep = callback(now)
+                except Exception as e:
+                    logger.error(f"Motion clock subscriber failed: {e}")
+                    keep = False
+                if not keep:
+                    self._subscribers.pop(subscription_id, None)
+        finally:
+            self._dispatching = False
+
+        if not self._subscribers:
+            self._source_id = None
+            return False
+        if self._source_interval_ms != self._interval_ms:
+            # 间隔在分发期间被修改，换一个新的定时器
+            self._source_id = None
+            self._start()
+            return False
+        return True
+
+    @classmethod
+    def reset_singleton(cls) -> None:
+        """重置单例状态 - 窗口重新打开时使用"""
+        if cls._instance is not None:
+            cls._instance._stop()
+        cls._instance = None
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+运动预测
+用 alpha-beta 滤波估计速度，把触摸位置向前外推一小段时间，抵消输入管线的延迟
+"""
+
+import math
+import os
+from typing import Callable, TextIO
+
+# 设置后把每个输入采样追加到这个文件（CSV: 时间,x,y），供 tests/bench_motion_predictor.py --trace 回放
+TRACE_ENV = "WAYDROID_HELPER_MOTION_TRACE"
+_trace_file: TextIO | None = None
+
+
+def _record(x: float, y: float, timestamp: float) -> None:
+    global _trace_file
+    if _trace_file is None:
+        _trace_file = open(os.environ[TRACE_ENV], "a", encoding="utf-8")
+    _trace_file.write(f"{timestamp:.6f},{x:.2f},{y:.2f}\n")
+    _trace_file.flush()
+
+
+class MotionPredictor:
+    """
+    alpha-beta 运动预测器
+
+    update() takes raw samples and returns the sample shifted along the
+    filtered velocity by lead_time seconds. The shift is limited to
+    max_lead_distance pixels and dropped while the motion reverses, which
+    keeps the overshoot on sudden stops and flicks bounded.
+
+    With auto set, lead_time is ignored and the lead is half the round trip
+    reported by latency_source (the one-way delay of the control channel),
+    capped at MAX_AUTO_LEAD and re-read every AUTO_REFRESH seconds. While
+    there is no fresh measurement the fixed lead_time is used instead.
+
+    With WAYDROID_HELPER_MOTION_TRACE set to a file path, every input
+    sample is appended to it so the filter can be tuned on recorded input.
+    """
+
+    # 两次采样间隔超过这个值时视为新的运动，重新估计速度
+    MAX_SAMPLE_GAP = 0.1
+    MAX_AUTO_LEAD = 0.05
+    AUTO_REFRESH = 1.0
+
+    def __init__(
+        self,
+        lead_time: float = 0.0,
+        alpha: float = 0.5,
+        beta: float = 0.1,
+        max_lead_distance: float = 40.0,
+        latency_source: Callable[[], float | None] | None = None,
+    ):
+        self.lead_time: float = lead_time
+        # 返回往返延迟（毫秒）的函数，没有测量值时返回 None
+        self.latency_source = latency_source
+        self.auto: bool = False
+        self._auto_lead: float | None = None
+        self._auto_read_at: float | None = None
+        self.alpha: float = alpha
+        self.beta: float = beta
+        self.max_lead_distance: float = max_lead_distance
+        self.reset()
+
+    @property
+    def enabled(self) -> bool:
+        return self.auto or self.lead_time > 0
+
+    def _lead(self, timestamp: float) -> float:
+        if not self.auto:
+            return self.lead_time
+        if self._auto_read_at is None or abs(timestamp - self._auto_read_at) >= self.AUTO_REFRESH:
+            self._auto_read_at = timestamp
+            rtt_ms = self.latency_source() if self.latency_source is not None else None
+            self._auto_lead = None if rtt_ms is None else min(self.MAX_AUTO_LEAD, max(0.0, rtt_ms) / 2000)
+        return self.lead_time if self._auto_lead is None else self._auto_lead
+
+    def reset(self) -> None:
+        self._time: float | None = None
+        self._x: float = 0.0
+        self._y: float = 0.0
+        self._vx: float = 0.0
+        self._vy: float = 0.0
+        self._raw_x: float = 0.0
+        self._raw_y: float = 0.0
+
+    def update(self, x: float, y: float, timestamp: float) -> tuple[float, float]:
+        """
+        输入一个采样，返回预测位置
+
+        Args:
+            x, y: Sampled position
+            timestamp: Sample time in seconds (any monotonic base)
+        """
+        if TRACE_ENV in os.environ:
+            _record(x, y, timestamp)
+        last_time = self._time
+        step_x = x - self._raw_x
+        step_y = y - self._raw_y
+        self._raw_x = x
+        self._raw_y = y
+        self._time = timestamp
+
+        if last_time is None:
+            self._x, self._y = x, y
+            self._vx = self._vy = 0.0
+            return x, y
+
+        dt = timestamp - last_time
+        if dt <= 0 or dt > self.MAX_SAMPLE_GAP:
+            # 时间戳相同时只更新位置；间隔太长时重新开始
+            self._x, self._y = x, y
+            if dt > self.MAX_SAMPLE_GAP:
+                self._vx = self._vy = 0.0
+            return x, y
+
+        # 预测 -> 残差 -> 修正位置和速度
+        predicted_x = self._x + self._vx * dt
+        predicted_y = self._y + self._vy * dt
+        residual_x = x - predicted_x
+        residual_y = y - predicted_y
+        self._x = predicted_x + self.alpha * residual_x
+        self._y = predicted_y + self.alpha * residual_y
+        self._vx += self.beta * residual_x / dt
+        self._vy += self.beta * residual_y / dt
+
+        lead_time = self._lead(timestamp) if self.enabled else 0.0
+        if lead_time <= 0:
+            return x, y
+
+        # 方向反转时不外推，避免在折返处越过真实位置
+        if step_x * self._vx + step_y * self._vy <= 0:
+            return x, y
+
+        lead_x = self._vx * lead_time
+        lead_y = self._vy * lead_time
+        distance = math.hypot(lead_x, lead_y)
+        if distance > self.max_lead_distance:
+            scale = self.max_lead_distance / distance
+            lead_x *= scale
+            lead_y *= scale
+        return x + lead_x, y + lead_y
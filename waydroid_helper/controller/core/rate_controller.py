@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""
+运动输出频率自适应
+根据发送队列深度和设备往返延迟调整 MotionClock 的节拍间隔
+"""
+
+from typing import Callable
+
+from waydroid_helper.config.file_manager import ConfigManager as FileConfigManager
+from waydroid_helper.controller.core.clock import get_clock
+from waydroid_helper.controller.core.latency_probe import LatencyProbe
+from waydroid_helper.controller.core.motion_clock import MotionClock
+from waydroid_helper.util.idle import IdleMonitor
+from waydroid_helper.util.log import logger
+
+
+class OutputRateController:
+    """
+    运动输出频率控制
+
+    Every SAMPLE_INTERVAL seconds the send queue depth and the device RTT
+    are read. The RTT is the median of the probe samples from the last
+    RTT_MAX_AGE seconds, so a single spike does not move the rate and an
+    old sample does not hold it down; with fewer than RTT_MIN_SAMPLES
+    fresh samples the median is not used. The probe already leaves out
+    replies dominated by clipboard payload. A request still unanswered
+    after LatencyProbe.TIMEOUT counts as a stall with its age, and lost
+    requests are ignored. If either is above its high mark, the device is
+    saturated and the tick interval is multiplied by BACKOFF_FACTOR. If
+    both stay below their low marks for HEADROOM_SAMPLES samples in a row,
+    the interval shrinks by STEP_MS. Backing off fast and recovering slowly
+    keeps the rate from oscillating around the point where the device
+    starts to queue.
+
+    Every subscriber of MotionClock (Aim, the mouse handler, smooth movers)
+    follows the new interval on its next tick. Each change is logged.
+
+    Config (config.json):
+        controller.output_rate.enabled: bool, default true
+        controller.output_rate.min_interval_ms: fastest interval, default 16
+        controller.output_rate.max_interval_ms: slowest interval, default 50
+        controller.output_rate.queue_high / queue_low: messages, default 64 / 8
+        controller.output_rate.rtt_high_ms / rtt_low_ms: default 60 / 25
+    """
+
+    CONFIG_KEY = "controller.output_rate"
+    SAMPLE_INTERVAL = 1.0
+    BACKOFF_FACTOR = 1.5
+    STEP_MS = 1
+    HEADROOM_SAMPLES = 3
+    RTT_MAX_AGE = 10.0
+    RTT_MIN_SAMPLES = 3
+
+    def __init__(
+        self,
+        queue_depth: Callable[[], int],
+        probe: LatencyProbe | None = None,
+    ):
+        self.queue_depth = queue_depth
+        self.probe = probe
+        self._source_id: int | None = None
+        self._idle_id: int | None = None
+        self._headroom: int = 0
+
+        options = FileConfigManager().get_value(self.CONFIG_KEY, {})
+        if not isinstance(options, dict):
+            options = {}
+
+        def option(name: str, default: float) -> float:
+            try:
+                return float(options.get(name, default))
+            except (TypeError, ValueError):
+                return default
+
+        self.enabled = bool(options.get("enabled", True))
+        self.min_interval_ms = int(
+            max(MotionClock.MIN_INTERVAL_MS, option("min_interval_ms", MotionClock.DEFAULT_INTERVAL_MS))
+        )
+        self.max_interval_ms = int(
+            max(self.min_interval_ms, min(MotionClock.MAX_INTERVAL_MS, option("max_interval_ms", 50)))
+        )
+        self.queue_high = option("queue_high", 64)
+        self.queue_low = option("queue_low", 8)
+        self.rtt_high_ms = option("rtt_high_ms", 60)
+        self.rtt_low_ms = option("rtt_low_ms", 25)
+
+    def start(self) -> None:
+        if not self.enabled or self._source_id is not None:
+            return
+        motion_clock = MotionClock()
+        motion_clock.set_interval_ms(
+            max(self.min_interval_ms, min(self.max_interval_ms, motion_clock.interval_ms))
+        )
+        # 空闲时没有运动输出，也不需要采样
+        self._idle_id = IdleMonitor().register(on_idle=self._stop_timer, on_active=self._start_timer)
+        self._start_timer()
+
+    def stop(self) -> None:
+        self._stop_timer()
+        IdleMonitor().unregister(self._idle_id)
+        self._idle_id = None
+
+    def _start_timer(self) -> None:
+        if self._source_id is None:
+            self._headroom = 0
+            self._source_id = get_clock().timeout_add(int(self.SAMPLE_INTERVAL * 1000), self._sample)
+
+    def _stop_timer(self) -> None:
+        if self._source_id is not None:
+            get_clock().source_remove(self._source_id)
+            self._source_id = None
+
+    def _rtt_ms(self) -> float:
+        if self.probe is None:
+            return 0.0
+        median = self.probe.median_ms(self.RTT_MAX_AGE, self.RTT_MIN_SAMPLES)
+        return max(median or 0.0, self.probe.stall_ms())
+
+    def _sample(self) -> bool:
+        depth = self.queue_depth()
+        rtt = self._rtt_ms()
+        motion_clock = MotionClock()
+        interval = motion_clock.interval_ms
+
+        if depth >= self.queue_high or rtt >= self.rtt_high_ms:
+            self._headroom = 0
+            new_interval = min(self.max_interval_ms, round(interval * self.BACKOFF_FACTOR))
+            reason = "saturated"
+        elif depth <= self.queue_low and rtt <= self.rtt_low_ms:
+            self._headroom += 1
+            if self._headroom < self.HEADROOM_SAMPLES:
+                return True
+            self._headroom = 0
+            new_interval = max(self.min_interval_ms, interval - self.STEP_MS)
+            reason = "headroom"
+        else:
+            self._headroom = 0
+            return True
+
+        if new_interval != interval:
+            motion_clock.set_interval_ms(new_interval)
+            logger.info(
+                f"Motion output interval {interval}ms -> {new_interval}ms ({reason}: "
+                f"queue {depth}, rtt {rtt:.1f}ms)"
+            )
+        return True
@@ -1,12 +1,29 @@
 import asyncio
+import os
+import socket
 
+from waydroid_helper.config.file_manager import ConfigManager as FileConfigManager
 from waydroid_helper.controller.core.control_msg import ControlMsg
+from waydroid_helper.controller.core.device_msg import read_device_msg
 from waydroid_helper.controller.core.event_bus import (Event, EventType,
                                                        EventBus)
+from waydroid_helper.controller.core.injection_writer import InjectionWriter
+from waydroid_helper.util.idle import IdleMonitor
 from waydroid_helper.util.log import logger
 
 
 class Server:
+    """
+    控制 socket 服务器
+
+    Runs on the GTK thread's asyncio loop, like the widgets that produce
+    the messages. With controller.writer_thread.enabled set, socket writes
+    are done by a dedicated InjectionWriter thread instead (see
+    _create_injection_writer).
+    """
+
+    WRITER_CONFIG_KEY = "controller.writer_thread"
+
     def __init__(self, host: str = "0.0.0.0", port: int = 10721, event_bus: EventBus|None = None):
         self.host: str = host
         self.port: int = port
@@ -19,17 +36,45 @@ class Server:
         self.server: asyncio.Server | None = None
         self.writers: list[asyncio.StreamWriter] = []
         self.started_event = asyncio.Event()
+        self.injection_writer: InjectionWriter | None = self._create_injection_writer()
         self.server_task: asyncio.Task[None] = asyncio.create_task(self.start_server())
 
         Server._initialized = True
         logger.info(f"Server singleton initialized on {host}:{port}")
 
+    def _create_injection_writer(self) -> InjectionWriter | None:
+        """
+        按配置创建写线程
+
+        Config (config.json):
+            controller.writer_thread.enabled: bool, default false
+            controller.writer_thread.realtime: bool, default true
+            controller.writer_thread.cpu: CPU index to pin to, default none
+        """
+        options = FileConfigManager().get_value(self.WRITER_CONFIG_KEY, {})
+        if not isinstance(options, dict) or not options.get("enabled", False):
+            return None
+        cpu = options.get("cpu")
+        writer = InjectionWriter(
+            realtime=bool(options.get("realtime", True)),
+            cpu=cpu if isinstance(cpu, int) else None,
+        )
+        writer.start()
+        return writer
+
     async def handler(self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter):
         addr = writer.get_extra_info("peername")
         logger.info(f"Connected to {addr!r}")
-        info = await reader.read(64)
-        logger.info(f"Connected to {info.decode()}")
+        # 设备名固定 64 字节，必须读完整，否则后面的设备消息会错位
+        info = await reader.readexactly(64)
+        device_name = info.rstrip(b"\0").decode(errors="replace")
+        logger.info(f"Connected to {device_name}")
         self.writers.append(writer)
+        reader_task = asyncio.create_task(self.read_device_msgs(reader))
+
+        if self.injection_writer is not None:
+            await self._handle_with_writer_thread(addr, writer, reader_task)
+            return
 
         try:
             while True:
@@ -39,10 +84,60 @@ class Server:
                 writer.write(message)
         finally:
             logger.info(f"Closing the connection to {addr!r}")
+            reader_task.cancel()
+            self.writers.remove(writer)
+            writer.close()
+            await writer.wait_closed()
+
+    async def _handle_with_writer_thread(
+        self,
+        addr: object,
+        writer: asyncio.StreamWriter,
+        reader_task: asyncio.Task[None],
+    ):
+        """写线程模式：写线程拿到 socket 的副本，这里只负责读取和清理"""
+        assert self.injection_writer is not None
+        transport_sock = writer.get_extra_info("socket")
+        sock = socket.socket(fileno=os.dup(transport_sock.fileno()))
+        sock.setblocking(True)
+        self.injection_writer.attach(sock)
+        try:
+            await reader_task
+        except asyncio.CancelledError:
+            pass
+        finally:
+            logger.info(f"Closing the connection to {addr!r}")
+            self.injection_writer.detach()
             self.writers.remove(writer)
             writer.close()
             await writer.wait_closed()
 
+    async def read_device_msgs(self, reader: asyncio.StreamReader):
+        """读取设备发回的消息并发到事件总线"""
+        try:
+            while True:
+                msg = await read_device_msg(reader)
+                if logger.isEnabledFor(10):
+                    logger.debug("Receive: %s", msg)
+                IdleMonitor().notify_activity("device")
+                self.event_bus.emit(Event(EventType.DEVICE_MSG, self, msg))
+        except asyncio.IncompleteReadError:
+            logger.info("Device message stream closed")
+        except ValueError as e:
+            logger.error(f"Stop reading device messages: {e}")
+
+    @property
+    def connected(self) -> bool:
+        """是否有设备连接"""
+        return bool(self.writers)
+
+    @property
+    def queue_depth(self) -> int:
+        """还没写入 socket 的控制消息数量"""
+        if self.injection_writer is not None:
+            return len(self.injection_writer.ring)
+        return self.message_queue.qsize()
+
     async def start_server(self):
         try:
             self.server = await asyncio.start_server(self.handler, self.host, self.port)
@@ -61,6 +156,8 @@ class Server:
         await self.started_event.wait()
 
     async def close(self):
+        if self.injection_writer is not None:
+            self.injection_writer.stop()
         if not self.server:
             return
 
@@ -86,16 +183,11 @@ class Server:
         logger.info("Server closed.")
 
     def send(self, msg: bytes):
-        """优化版本：直接使用 put_nowait，避免额外的函数调用开销"""
-        try:
-            self.message_queue.put_nowait(msg)
-        except asyncio.QueueFull:
-            # 如果队列满了，丢弃最旧的消息以避免阻塞
-            try:
-                self.message_queue.get_nowait()
-                self.message_queue.put_nowait(msg)
-            except asyncio.QueueEmpty:
-                pass
+        """把消息交给写线程或连接处理协程"""
+        if self.injection_writer is not None:
+            self.injection_writer.push(msg)
+            return
+        self.message_queue.put_nowait(msg)
 
     def send_msg(self, event: Event[ControlMsg]):
         """优化版本：减少日志调用和条件检查"""
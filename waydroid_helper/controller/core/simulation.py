@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+虚拟时间模拟
+在虚拟时钟上驱动组件：按脚本注入输入事件、推进时间，并记录发出的控制消息。
+用于回归比对和性能测量，不连接设备，也不依赖真实时间
+"""
+
+import asyncio
+from typing import Any, Callable, Iterable
+
+from waydroid_helper.controller.core.clock import Clock, VirtualClock, set_clock
+from waydroid_helper.controller.core.control_msg import ControlMsg
+from waydroid_helper.controller.core.event_bus import Event, EventBus, EventType
+from waydroid_helper.controller.core.handler.event_handlers import (
+    InputEvent,
+    InputEventHandlerChain,
+)
+from waydroid_helper.controller.core.motion_clock import MotionClock
+
+# (虚拟时间, 事件)
+ScriptStep = tuple[float, InputEvent]
+
+
+class Simulation:
+    """
+    虚拟时间模拟器
+
+    While active, the global clock is a VirtualClock and every action runs
+    inside a private asyncio loop, so widgets can create tasks and sleep as
+    they do in the app. Input events go through the given handler chain the
+    same way the window sends them; mouse motion is also emitted on the
+    event bus as MOUSE_MOTION. Every CONTROL_MSG is recorded together with
+    the virtual time it was emitted at.
+
+    Widgets that start tasks in __init__ (e.g. SkillCasting) must be created
+    through call() so the tasks land on the simulation loop.
+
+        with Simulation(event_bus, chain) as sim:
+            widget = sim.call(SkillCasting, event_bus=event_bus, ...)
+            sim.run_script([(0.0, press), (0.3, release)], until=1.0)
+            messages = sim.messages
+    """
+
+    # 每次推进后让事件循环多跑几轮，把被唤醒的协程及其新建的任务都执行完
+    DRAIN_ITERATIONS = 16
+
+    def __init__(
+        self,
+        event_bus: EventBus,
+        handler_chain: InputEventHandlerChain | None = None,
+        start_time: float = 0.0,
+    ):
+        self.event_bus = event_bus
+        self.handler_chain = handler_chain
+        self.clock = VirtualClock(start_time)
+        self.messages: list[tuple[float, ControlMsg]] = []
+        self.loop = asyncio.new_event_loop()
+        self._previous_clock: Clock | None = None
+        self._active = False
+
+    def __enter__(self) -> "Simulation":
+        self.start()
+        return self
+
+    def __exit__(self, *exc_info: object) -> None:
+        self.stop()
+
+    def start(self) -> None:
+        if self._active:
+            return
+        self._active = True
+        # 运动时钟的定时器属于启动它时的时钟，换时钟前先重置
+        MotionClock.reset_singleton()
+        self._previous_clock = set_clock(self.clock)
+        self.event_bus.subscribe(EventType.CONTROL_MSG, self._on_control_msg, subscriber=self)
+
+    def stop(self) -> None:
+        if not self._active:
+            return
+        self._active = False
+        self.event_bus.unsubscribe_by_subscriber(self)
+        for task in asyncio.all_tasks(self.loop):
+            task.cancel()
+        self._drain()
+        MotionClock.reset_singleton()
+        set_clock(self._previous_clock)
+        self._previous_clock = None
+        self.loop.close()
+
+    @property
+    def now(self) -> float:
+        return self.clock.now()
+
+    def _on_control_msg(self, event: Event[ControlMsg]) -> None:
+        self.messages.append((self.clock.now(), event.data))
+
+    def _drain(self) -> None:
+        async def yield_to_tasks() -> None:
+            for _ in range(self.DRAIN_ITERATIONS):
+                await asyncio.sleep(0)
+
+        self.loop.run_until_complete(yield_to_tasks())
+
+    def call(self, func: Callable[..., Any], *args: Any, **kwargs: Any) -> Any:
+        """在模拟的事件循环里同步调用 func，返回其结果"""
+
+        async def invoke() -> Any:
+            return func(*args, **kwargs)
+
+        result = self.loop.run_until_complete(invoke())
+        self._drain()
+        return result
+
+    def feed(self, event: InputEvent) -> bool:
+        """按窗口的方式分发一个输入事件"""
+
+        def dispatch() -> bool:
+            if event.event_type == "mouse_motion":
+                self.event_bus.emit(Event(EventType.MOUSE_MOTION, self, event))
+            if self.handler_chain is None:
+                return False
+            return self.handler_chain.process_event(event)
+
+        return bool(self.call(dispatch))
+
+    def advance(self, seconds: float) -> None:
+        self.advance_to(self.clock.now() + seconds)
+
+    def advance_to(self, deadline: float) -> None:
+        """推进到 deadline，每个到期的定时器之后都让协程跑完再继续"""
+        while True:
+            next_deadline = self.clock.next_deadline()
+            if next_deadline is None or next_deadline > deadline:
+                break
+            self.loop.run_until_complete(self._fire_until(next_deadline))
+            self._drain()
+        self.clock.advance_to(deadline)
+
+    async def _fire_until(self, deadline: float) -> None:
+        # 定时器回调里可能会创建任务，需要在事件循环运行时触发
+        self.clock.advance_to(deadline)
+
+    def run_script(self, steps: Iterable[ScriptStep], until: float | None = None) -> None:
+        """按时间顺序注入事件；until 给出时在最后继续推进到该时间"""
+        for at, event in sorted(steps, key=lambda step: step[0]):
+            self.advance_to(at)
+            self.feed(event)
+        if until is not None:
+            self.advance_to(until)
+
+    def clear_messages(self) -> None:
+        self.messages.clear()
@@ -0,0 +1,368 @@
+#!/usr/bin/env python3
+"""
+长时间运行检查
+在虚拟时间里持续注入输入并切换配置，定期记录内存、任务和信号连接数量，
+结束时检查这些数值是否在持续增长
+"""
+
+import asyncio
+import os
+import random
+import tracemalloc
+from dataclasses import dataclass, field
+from typing import Callable, Iterable
+
+from waydroid_helper.controller.core.event_bus import EventBus
+from waydroid_helper.controller.core.growth import growth_failures
+from waydroid_helper.controller.core.handler.event_handlers import InputEvent
+from waydroid_helper.controller.core.key_system import Key, KeyType
+from waydroid_helper.controller.core.simulation import ScriptStep, Simulation
+from waydroid_helper.util.log import logger
+
+
+@dataclass
+class ResourceSample:
+    """一次资源采样"""
+
+    elapsed: float  # 虚拟时间，秒
+    rss_kb: int
+    traced_kb: int
+    tasks: int
+    connections: int
+    handlers: int
+    handlers_by_event: dict[str, int] = field(default_factory=dict)
+
+
+class ResourceMonitor:
+    """
+    资源采样
+
+    RSS comes from /proc/self/statm, Python allocations from tracemalloc.
+    Connections are the live EventBus subscriptions (each one is a signal
+    connection on the GlobalEventEmitter); handlers counts the HandlerInfo
+    entries of both EventBus and the emitter, which is where a forgotten
+    subscription shows up first.
+    """
+
+    def __init__(self, event_bus: EventBus, loop: asyncio.AbstractEventLoop):
+        self.event_bus = event_bus
+        self.loop = loop
+        self.samples: list[ResourceSample] = []
+        self._baseline: tracemalloc.Snapshot | None = None
+        self._started_tracemalloc: bool = False
+
+    def start(self) -> None:
+        if not tracemalloc.is_tracing():
+            tracemalloc.start(10)
+            self._started_tracemalloc = True
+        self._baseline = tracemalloc.take_snapshot()
+
+    def stop(self) -> None:
+        if self._started_tracemalloc:
+            tracemalloc.stop()
+            self._started_tracemalloc = False
+        self._baseline = None
+
+    @staticmethod
+    def _rss_kb() -> int:
+        try:
+            with open("/proc/self/statm") as f:
+                pages = int(f.read().split()[1])
+        except (OSError, IndexError, ValueError):
+            return 0
+        return pages * os.sysconf("SC_PAGE_SIZE") // 1024
+
+    def sample(self, elapsed: float) -> ResourceSample:
+        # 模拟用自己的 asyncio 循环，GLib 的空闲回调不会运行
+        self.event_bus.process_collected()
+        handlers_by_event = self.event_bus.handler_counts()
+
+        traced, _peak = tracemalloc.get_traced_memory() if tracemalloc.is_tracing() else (0, 0)
+        sample = ResourceSample(
+            elapsed=elapsed,
+            rss_kb=self._rss_kb(),
+            traced_kb=traced // 1024,
+            tasks=len(asyncio.all_tasks(self.loop)),
+            connections=self.event_bus.subscription_count,
+            handlers=sum(handlers_by_event.values()),
+            handlers_by_event=handlers_by_event,
+        )
+        self.samples.append(sample)
+        return sample
+
+    def top_allocations(self, limit: int = 10) -> list[str]:
+        """相对 start() 时增长最多的分配位置"""
+        if self._baseline is None or not tracemalloc.is_tracing():
+            return []
+        snapshot = tracemalloc.take_snapshot()
+        stats = snapshot.compare_to(self._baseline, "traceback")
+        return [str(stat) for stat in stats[:limit] if stat.size_diff > 0]
+
+
+class SoakTest:
+    """
+    长时间运行检查
+
+    Each cycle feeds the steps returned by the input script, then the
+    profile is switched every profile_interval seconds and resources are
+    sampled every sample_interval seconds. All of it runs in virtual time,
+    so hours of play take minutes.
+
+    A metric fails when, after the warm-up part of the run, every sample in
+    the last third is above every sample in the first third and the mean
+    grew by more than the metric's tolerance. Noise and one-off caches do
+    not trip it; a leak of one task or subscription per cast does.
+    The rule itself is growth_failures, which has no Gtk dependency.
+    """
+
+    # 前 WARMUP_FRACTION 的采样不参与判断，给缓存和首次创建留出余量
+    WARMUP_FRACTION = 0.2
+
+    # 指标 -> 允许的增长量
+    TOLERANCES: dict[str, int] = {
+        "rss_kb": 8 * 1024,
+        "traced_kb": 2 * 1024,
+        "tasks": 2,
+        "connections": 2,
+        "handlers": 2,
+    }
+
+    def __init__(
+        self,
+        simulation: Simulation,
+        input_script: Callable[[float], Iterable[ScriptStep]],
+        switch_profile: Callable[[int], None] | None = None,
+        cycle_seconds: float = 10.0,
+        sample_interval: float = 60.0,
+        profile_interval: float = 300.0,
+    ):
+        self.simulation = simulation
+        self.input_script = input_script
+        self.switch_profile = switch_profile
+        self.cycle_seconds = cycle_seconds
+        self.sample_interval = sample_interval
+        self.profile_interval = profile_interval
+        self.monitor = ResourceMonitor(simulation.event_bus, simulation.loop)
+        self.failures: list[str] = []
+
+    def run(self, duration: float) -> bool:
+        """运行 duration 秒虚拟时间，没有发现持续增长时返回 True"""
+        sim = self.simulation
+        start = sim.now
+        next_sample = start
+        next_profile = start + self.profile_interval
+        profile_index = 0
+
+        self.monitor.start()
+        try:
+            while sim.now - start < duration:
+                cycle_start = sim.now
+                sim.run_script(self.input_script(cycle_start), until=cycle_start + self.cycle_seconds)
+                # 每轮只保留最近的消息，避免记录本身变成泄漏
+                sim.clear_messages()
+
+                if self.switch_profile is not None and sim.now >= next_profile:
+                    profile_index += 1
+                    sim.call(self.switch_profile, profile_index)
+                    next_profile += self.profile_interval
+
+                if sim.now >= next_sample:
+                    sample = self.monitor.sample(sim.now - start)
+                    logger.debug(
+                        f"Soak {sample.elapsed:.0f}s: rss {sample.rss_kb}KiB, "
+                        f"traced {sample.traced_kb}KiB, tasks {sample.tasks}, "
+                        f"connections {sample.connections}, handlers {sample.handlers}"
+                    )
+                    next_sample += self.sample_interval
+
+            self.monitor.sample(sim.now - start)
+            return self.check_growth()
+        finally:
+            if self.failures:
+                for line in self.monitor.top_allocations():
+                    logger.info(f"Soak allocation growth: {line}")
+            self.monitor.stop()
+
+    def check_growth(self) -> bool:
+        failures = growth_failures(self.monitor.samples, self.TOLERANCES, self.WARMUP_FRACTION)
+        if failures is None:
+            logger.warning(
+                f"Soak test has only {len(self.monitor.samples)} samples, growth not checked"
+            )
+            self.failures = []
+            return True
+
+        self.failures = failures
+        for failure in self.failures:
+            logger.error(f"Soak test: {failure}")
+        return not self.failures
+
+def random_input_script(
+    keys: list[Key],
+    screen_size: tuple[int, int],
+    seed: int = 0,
+    presses_per_cycle: int = 20,
+    cycle_seconds: float = 10.0,
+) -> Callable[[float], list[ScriptStep]]:
+    """
+    生成随机输入脚本：按键按下/抬起，中间穿插鼠标移动
+
+    Mouse buttons in keys are sent as mouse_press/mouse_release with a
+    position, keyboard keys as key_press/key_release.
+    """
+    rng = random.Random(seed)
+    width, height = screen_size
+
+    def position() -> tuple[int, int]:
+        return rng.randrange(width), rng.randrange(height)
+
+    def cycle(start: float) -> list[ScriptStep]:
+        steps: list[ScriptStep] = []
+        slot = cycle_seconds / presses_per_cycle
+        for index in range(presses_per_cycle):
+            key = rng.choice(keys)
+            pressed_at = start + index * slot
+            held = rng.uniform(0.02, slot * 0.8)
+            is_mouse = key.key_type == KeyType.MOUSE
+            # 鼠标按键的 keyval 是按钮号取负
+            button = -key.keyval if is_mouse else None
+            steps.append((
+                pressed_at,
+                InputEvent(
+                    event_type="mouse_press" if is_mouse else "key_press",
+                    key=key,
+                    button=button,
+                    position=position(),
+                ),
+            ))
+            for step in range(1, 5):
+                steps.append((
+                    pressed_at + held * step / 5,
+                    InputEvent(event_type="mouse_motion", position=position()),
+                ))
+            steps.append((
+                pressed_at + held,
+                InputEvent(
+                    event_type="mouse_release" if is_mouse else "key_release",
+                    key=key,
+                    button=button,
+                    position=position(),
+                ),
+            ))
+        return steps
+
+    return cycle
+
+
+# 轮换使用的布局：(组件类型, x, y, 按键名)
+SOAK_PROFILES: list[list[tuple[str, int, int, str]]] = [
+    [
+        ("singleclick", 1500, 800, "Q"),
+        ("repeatedclick", 1650, 700, "E"),
+        ("skillcasting", 1400, 600, "R"),
+        ("singleclick", 960, 540, "Mouse_Left"),
+    ],
+    [
+        ("skillcasting", 1300, 750, "Q"),
+        ("skillcasting", 1500, 650, "E"),
+        ("singleclick", 1700, 850, "R"),
+        ("repeatedclick", 960, 540, "Mouse_Left"),
+    ],
+]
+
+SOAK_SCREEN_SIZE = (1920, 1080)
+
+
+def run_soak(hours: float, seed: int = 0) -> bool:
+    """
+    用内置的布局跑一次长时间运行检查，没有持续增长时返回 True
+
+    Widgets are created through the factory and routed by the same
+    KeyMappingManager / handler chain the window uses, with SOAK_PROFILES
+    swapped in turn as the profile switch. Sampling and profile intervals
+    scale with short runs so that a few virtual minutes still give enough
+    samples for the growth check.
+    """
+    from gi.repository import Gtk
+
+    from waydroid_helper.controller.core.control_msg import ScreenInfo
+    from waydroid_helper.controller.core.handler.event_handlers import (
+        InputEventHandlerChain,
+    )
+    from waydroid_helper.controller.core.handler.mapping.key_mapping_event_handler import (
+        KeyMappingEventHandler,
+    )
+    from waydroid_helper.controller.core.handler.mapping.key_mapping_manager import (
+        KeyMappingManager,
+    )
+    from waydroid_helper.controller.core.key_system import KeyCombination, KeyRegistry
+    from waydroid_helper.controller.core.utils import PointerIdManager
+    from waydroid_helper.controller.widgets.factory import WidgetFactory
+
+    duration = hours * 3600
+    screen_info = ScreenInfo()
+    screen_info.set_resolution(*SOAK_SCREEN_SIZE)
+    screen_info.set_host_resolution(*SOAK_SCREEN_SIZE)
+
+    event_bus = EventBus()
+    key_registry = KeyRegistry()
+    pointer_id_manager = PointerIdManager()
+    key_mapping_manager = KeyMappingManager(event_bus)
+    chain = InputEventHandlerChain()
+    chain.add_handler(KeyMappingEventHandler(key_mapping_manager))
+    factory = WidgetFactory()
+    fixed = Gtk.Fixed()
+    widgets: list[Gtk.Widget] = []
+
+    def clear() -> None:
+        for widget in widgets:
+            key_mapping_manager.unsubscribe(widget)
+            fixed.remove(widget)
+            widget.on_delete()
+        widgets.clear()
+
+    def switch_profile(index: int) -> None:
+        clear()
+        for widget_type, x, y, key_name in SOAK_PROFILES[index % len(SOAK_PROFILES)]:
+            key = key_registry.get_by_name(key_name)
+            if key is None:
+                continue
+            key_combination = KeyCombination([key])
+            widget = factory.create_widget(
+                widget_type,
+                x=x,
+                y=y,
+                event_bus=event_bus,
+                pointer_id_manager=pointer_id_manager,
+                key_registry=key_registry,
+                default_keys=[key_combination],
+            )
+            if widget is None:
+                continue
+            fixed.put(widget, x, y)
+            widget.x, widget.y = x, y
+            widget.set_mapping_mode(True)
+            key_mapping_manager.subscribe(
+                widget, key_combination, reentrant=getattr(widget, "IS_REENTRANT", False)
+            )
+            widgets.append(widget)
+
+    keys = [
+        key
+        for key in (key_registry.get_by_name(name) for name in ("Q", "E", "R", "Mouse_Left"))
+        if key is not None
+    ]
+    with Simulation(event_bus, chain) as sim:
+        try:
+            sim.call(switch_profile, 0)
+            soak = SoakTest(
+                sim,
+                random_input_script(keys, SOAK_SCREEN_SIZE, seed=seed),
+                switch_profile=switch_profile,
+                sample_interval=min(60.0, duration / 12),
+                profile_interval=min(300.0, duration / 6),
+            )
+            return soak.run(duration)
+        finally:
+            sim.call(clear)
+            key_mapping_manager.clear()
@@ -156,10 +156,8 @@ class ContextMenuManager:
         # 过滤掉不允许通过右键菜单创建的组件
         filtered_types = []
         for widget_type in available_types:
-            widget_class = widget_factory.widget_classes.get(widget_type)
-            if widget_class and getattr(
-                widget_class, "ALLOW_CONTEXT_MENU_CREATION", True
-            ):
+            metadata = widget_factory.get_widget_metadata(widget_type)
+            if metadata.get("allow_context_menu_creation", True):
                 filtered_types.append(widget_type)
 
         if not filtered_types:
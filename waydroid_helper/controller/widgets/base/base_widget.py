@@ -11,6 +11,7 @@ from typing import TYPE_CHECKING, Any, Callable, TypedDict, cast
 
 import gi
 
+from waydroid_helper.controller.core.clock import Clock, get_clock
 from waydroid_helper.controller.core.key_system import KeyRegistry
 from waydroid_helper.controller.core.utils import PointerIdManager
 
@@ -23,6 +24,7 @@ from gi.repository import Gdk, GObject, Gtk
 from waydroid_helper.controller.core import (Event, EventType, KeyCombination,
                                              EventBus)
 from waydroid_helper.controller.widgets.config import ConfigManager
+from waydroid_helper.util.task import TaskScope, TaskSupervisor
 
 if TYPE_CHECKING:
     from cairo import Context, Surface
@@ -131,6 +133,18 @@ class BaseWidget(Gtk.DrawingArea):
         self.event_bus = event_bus
         self.pointer_id_manager = pointer_id_manager
         self.key_registry = key_registry
+        self._clock: Clock | None = None
+        # 组件的异步任务都放在这个作用域里，删除组件时一起取消
+        self.tasks: TaskScope = TaskSupervisor().scope(type(self).__name__, owner=self)
+
+    @property
+    def clock(self) -> Clock:
+        """计时用的时钟，未单独注入时跟随全局时钟"""
+        return self._clock if self._clock is not None else get_clock()
+
+    @clock.setter
+    def clock(self, clock: Clock | None) -> None:
+        self._clock = clock
 
     def set_default_keys(self, default_keys: set[KeyCombination]):
         self.final_keys = (set(default_keys))
@@ -599,3 +613,5 @@ class BaseWidget(Gtk.DrawingArea):
 
         # 清理事件总线订阅
         self.event_bus.unsubscribe_by_subscriber(self)
+
+        self.tasks.close()
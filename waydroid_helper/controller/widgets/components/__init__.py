@@ -1,21 +1,38 @@
 """
 具体组件实现
+
+Component modules are imported on first attribute access, so importing this
+package (e.g. for discovery) stays cheap.
 """
 
-from .aim import Aim
-from .cancel_casting import CancelCasting
-from .circle_tilt_radius_calibration import CircleTiltRadiusCalibration
-from .directional_pad import DirectionalPad
-from .fire import Fire
-from .macro import Macro
-from .repeated_click import RepeatedClick
-from .right_click_to_walk import RightClickToWalk
-from .single_click import SingleClick
-from .skill_casting import SkillCasting
+import importlib
+from typing import Any
+
+_LAZY_COMPONENTS = {
+    'Aim': 'aim',
+    'CancelCasting': 'cancel_casting',
+    'CircleTiltRadiusCalibration': 'circle_tilt_radius_calibration',
+    'DirectionalPad': 'directional_pad',
+    'Fire': 'fire',
+    'Macro': 'macro',
+    'RepeatedClick': 'repeated_click',
+    'RightClickToWalk': 'right_click_to_walk',
+    'SingleClick': 'single_click',
+    'SkillCasting': 'skill_casting',
+}
+
+
+def __getattr__(name: str) -> Any:
+    module_name = _LAZY_COMPONENTS.get(name)
+    if module_name is None:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    module = importlib.import_module(f"{__name__}.{module_name}")
+    return getattr(module, name)
+
 
 __all__ = [
     'Aim',
-    'Fire', 
+    'Fire',
     'SingleClick',
     'DirectionalPad',
     'CircleTiltRadiusCalibration',
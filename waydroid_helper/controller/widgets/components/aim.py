@@ -20,15 +20,19 @@ from waydroid_helper.controller.core import (
 from waydroid_helper.controller.core.control_msg import InjectTouchEventMsg, ScreenInfo
 from waydroid_helper.controller.core.event_bus import EventBus
 from waydroid_helper.controller.core.key_system import KeyRegistry
+from waydroid_helper.controller.core.latency_probe import measured_rtt_ms
+from waydroid_helper.controller.core.motion_predictor import MotionPredictor
 from waydroid_helper.controller.platform import get_platform
 from waydroid_helper.controller.widgets import BaseWidget
-from waydroid_helper.controller.widgets.config import create_slider_config
+from waydroid_helper.controller.widgets.config import (create_slider_config,
+                                                      create_switch_config)
 from waydroid_helper.controller.widgets.decorators import (
     Editable,
     Resizable,
     ResizableDecorator,
 )
 from waydroid_helper.util.log import logger
+from waydroid_helper.util.task import TaskSupervisor
 
 if TYPE_CHECKING:
     from cairo import Context, Surface
@@ -99,6 +103,7 @@ class Aim(BaseWidget):
 
         # 位置跟踪
         self._current_pos: tuple[float, float] | None = None
+        self._predictor = MotionPredictor(alpha=0.6, beta=0.2, latency_source=measured_rtt_ms)
 
         # 异步任务管理
         self._aim_task: asyncio.Task[None] | None = None
@@ -137,14 +142,57 @@ class Aim(BaseWidget):
             ),
         )
 
+        prediction_auto_config = create_switch_config(
+            key="prediction_auto",
+            label=pgettext("Controller Widgets", "Automatic Motion Prediction"),
+            value=False,
+            description=pgettext(
+                "Controller Widgets",
+                "Predicts ahead by the measured latency of the device connection. Uses the fixed time below until the latency is measured",
+            ),
+        )
+        prediction_config = create_slider_config(
+            key="prediction_ms",
+            label=pgettext("Controller Widgets", "Motion Prediction (ms)"),
+            value=0,
+            min_value=0,
+            max_value=50,
+            step=1,
+            description=pgettext(
+                "Controller Widgets",
+                "Extrapolates the aim position ahead by this time to offset input latency when automatic prediction is off or has no measurement yet. 0 disables prediction",
+            ),
+        )
+
         self.add_config_item(sensitivity_config)
+        self.add_config_item(prediction_auto_config)
+        self.add_config_item(prediction_config)
         # 添加配置变更回调
         self.add_config_change_callback("sensitivity", self._on_sensitivity_changed)
+        self.add_config_change_callback("prediction_auto", self._on_prediction_auto_changed)
+        self.add_config_change_callback("prediction_ms", self._on_prediction_changed)
+        self._on_prediction_auto_changed(
+            "prediction_auto", self.get_config_value("prediction_auto"), False
+        )
+        self._on_prediction_changed(
+            "prediction_ms", self.get_config_value("prediction_ms"), False
+        )
 
     def _on_sensitivity_changed(self, key: str, value: int, restoring: bool) -> None:
         """处理灵敏度配置变更"""
         pass
 
+    def _on_prediction_auto_changed(self, key: str, value: bool, restoring: bool) -> None:
+        """处理自动预测开关变更"""
+        self._predictor.auto = bool(value)
+
+    def _on_prediction_changed(self, key: str, value: int, restoring: bool) -> None:
+        """处理预测时间配置变更"""
+        try:
+            self._predictor.lead_time = max(0.0, float(value)) / 1000.0
+        except (TypeError, ValueError):
+            self._predictor.lead_time = 0.0
+
     async def _set_state(self, new_state: AimState) -> None:
         """安全地设置状态"""
         async with self._state_lock:
@@ -194,7 +242,7 @@ class Aim(BaseWidget):
 
         # 如果处理器没有运行，启动它
         if not self._motion_processor_running:
-            self._motion_task = asyncio.create_task(self._motion_processor())
+            self._motion_task = self.tasks.create_task(self._motion_processor(), name="motion")
 
     async def _motion_processor(self) -> None:
         """异步处理鼠标移动事件的处理器"""
@@ -250,6 +298,7 @@ class Aim(BaseWidget):
         # 如果没有当前位置，初始化为中心点
         if self._current_pos is None:
             self._current_pos = (float(self.center_x), float(self.center_y))
+            self._predictor.reset()
             await self._send_touch_down(w, h)
 
         # 计算新位置
@@ -261,6 +310,7 @@ class Aim(BaseWidget):
             # 超出边界，发送UP事件并重置位置
             await self._send_touch_up(w, h)
             self._current_pos = (float(self.center_x), float(self.center_y))
+            self._predictor.reset()
             # await asyncio.sleep(0.05)
             await self._send_touch_down(w, h)
             # self._current_pos = (float(self.center_x) + dx, float(self.center_y) + dy)
@@ -269,7 +319,14 @@ class Aim(BaseWidget):
 
         # 更新位置并发送MOVE事件
         self._current_pos = (new_x, new_y)
-        await self._send_touch_move(w, h)
+        predicted = self._predictor.update(new_x, new_y, self.clock.now())
+        if predicted != self._current_pos:
+            # 预测位置限制在瞄准区域内
+            predicted = (
+                min(max(predicted[0], self.x), self.x + self.width),
+                min(max(predicted[1], self.y), self.y + self.height),
+            )
+        await self._send_touch_move(w, h, predicted)
 
     async def _send_touch_down(self, w: int, h: int) -> None:
         """发送触摸按下事件"""
@@ -290,10 +347,13 @@ class Aim(BaseWidget):
         )
         self.event_bus.emit(Event(EventType.CONTROL_MSG, self, msg))
 
-    async def _send_touch_move(self, w: int, h: int) -> None:
-        """发送触摸移动事件"""
+    async def _send_touch_move(
+        self, w: int, h: int, position: tuple[float, float] | None = None
+    ) -> None:
+        """发送触摸移动事件，position 默认为当前位置"""
         if self._current_pos is None:
             return
+        pos_x, pos_y = position if position is not None else self._current_pos
 
         pointer_id = self.pointer_id_manager.get_allocated_id(self)
         if pointer_id is None:
@@ -302,7 +362,7 @@ class Aim(BaseWidget):
         msg = InjectTouchEventMsg(
             action=AMotionEventAction.MOVE,
             pointer_id=pointer_id,
-            position=(int(self._current_pos[0]), int(self._current_pos[1]), w, h),
+            position=(int(pos_x), int(pos_y), w, h),
             pressure=1.0,
             action_button=0,
             buttons=AMotionEventButtons.PRIMARY,
@@ -434,14 +494,14 @@ class Aim(BaseWidget):
         if self._aim_task and not self._aim_task.done():
             return  # 已经在瞄准状态
 
-        self._aim_task = asyncio.create_task(self._enter_aiming_state())
+        self._aim_task = self.tasks.create_task(self._enter_aiming_state(), name="aim")
 
     def _handle_exit_staring(self, event: Event[Any]) -> None:
         """处理退出瞄准事件 - 创建异步任务"""
         if self._aim_task and not self._aim_task.done():
             self._aim_task.cancel()
 
-        self._aim_task = asyncio.create_task(self._exit_aiming_state())
+        self._aim_task = self.tasks.create_task(self._exit_aiming_state(), name="aim")
 
     async def _enter_aiming_state(self) -> None:
         """异步进入瞄准状态"""
@@ -542,7 +602,7 @@ class Aim(BaseWidget):
             used_key = "未知按键"
 
         # 创建异步任务处理按键触发
-        asyncio.create_task(self._handle_key_triggered(used_key))
+        self.tasks.create_task(self._handle_key_triggered(used_key))
         return True
 
     async def _handle_key_triggered(self, used_key: str) -> None:
@@ -572,8 +632,8 @@ class Aim(BaseWidget):
         # 取消所有异步任务
         self._cancel_tasks()
 
-        # 如果处于瞄准状态，异步退出
-        asyncio.create_task(self._cleanup_async())
+        # 如果处于瞄准状态，异步退出；组件的作用域可能已关闭，放到根作用域
+        TaskSupervisor().root.create_task(self._cleanup_async())
 
     async def _cleanup_async(self) -> None:
         """异步清理"""
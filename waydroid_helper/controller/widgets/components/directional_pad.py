@@ -233,13 +233,13 @@ class DirectionalPad(BaseWidget):
 
         if use_smooth:
             # 创建平滑移动任务
-            self._movement_task = asyncio.create_task(
-                self._smooth_move_to(target)
+            self._movement_task = self.tasks.create_task(
+                self._smooth_move_to(target), name="movement"
             )
         else:
             # 创建瞬间移动任务
-            self._movement_task = asyncio.create_task(
-                self._instant_move_to(target)
+            self._movement_task = self.tasks.create_task(
+                self._instant_move_to(target), name="movement"
             )
 
     async def _instant_move_to(self, target: tuple[float, float]) -> None:
@@ -287,7 +287,7 @@ class DirectionalPad(BaseWidget):
 
                 # 等待下一帧
                 if move_steps_count < self._move_steps_total:
-                    await asyncio.sleep(self._move_interval)
+                    await self.clock.sleep(self._move_interval)
 
             # 确保到达最终位置
             self._current_position = target
@@ -12,6 +12,13 @@ from typing import TYPE_CHECKING, NamedTuple, cast
 
 from waydroid_helper.controller.android import AMotionEventAction, AMotionEventButtons
 from waydroid_helper.controller.core.control_msg import InjectTouchEventMsg, ScreenInfo
+from waydroid_helper.controller.core.gesture_path import (
+    EASINGS,
+    parse_gesture,
+    parse_pinch,
+    path_sampler,
+)
+from waydroid_helper.controller.core.motion_clock import MotionClock
 from waydroid_helper.util.log import logger
 
 if TYPE_CHECKING:
@@ -373,7 +380,7 @@ class ClickCommand(Command):
         await self.press_command.execute(context)
 
         # Wait 0.05 seconds between DOWN and UP events
-        await asyncio.sleep(0.05)
+        await context.clock.sleep(0.05)
 
         # Execute release command (UP events)
         await self.release_command.execute(context)
@@ -387,7 +394,188 @@ class SleepCommand(Command):
 
     async def execute(self, context: "Macro") -> None:
         if self.sleep_time > 0:
-            await asyncio.sleep(self.sleep_time)
+            await context.clock.sleep(self.sleep_time)
+
+class _GestureRun:
+    """一次手势执行的状态：每个手指的指针标识和当前位置"""
+
+    def __init__(self, fingers: int):
+        # 每次执行用新的标识，同一个命令重叠执行时不会共用指针
+        self.identifiers: list[tuple[int, int]] = [(id(self), finger) for finger in range(fingers)]
+        self.positions: list[tuple[float, float]] = []
+
+
+class GestureCommand(Command):
+    """
+    手势命令 - 一个或多个手指沿路径滑动
+
+    Each finger follows its own polyline; all fingers start and end
+    together. Positions are sampled on MotionClock ticks, so a gesture of
+    any length is one command and its output rate follows the shared
+    motion rate. The path is traversed by arc length, with the easing
+    applied to the fraction of the duration that has passed. Pointer ids
+    and positions belong to one execution (_GestureRun); the command only
+    keeps the running ones so cancel() can lift their fingers.
+    """
+
+    def __init__(
+        self,
+        fingers: list[list[str]],
+        duration: float,
+        easing: str = "linear",
+        hold: float = 0.0,
+    ):
+        # [["x,y", "x1,y1", ...], ...] 每个手指一条路径
+        self.fingers = fingers
+        self.duration = duration
+        self.easing = EASINGS.get(easing, EASINGS["linear"])
+        # 按下后停留多久才开始移动（拖动需要长按）
+        self.hold = hold
+        self._runs: set[_GestureRun] = set()
+
+    def _resolve_paths(self, context: "Macro") -> list[list[tuple[float, float]]]:
+        paths: list[list[tuple[float, float]]] = []
+        for finger in self.fingers:
+            path: list[tuple[float, float]] = []
+            for point in finger:
+                if point == "mouse":
+                    x, y = context.get_cursor_position()
+                else:
+                    x, y = point.split(",")
+                path.append((float(x), float(y)))
+            paths.append(path)
+        return paths
+
+    def _emit(
+        self,
+        context: "Macro",
+        action: AMotionEventAction,
+        identifier: tuple[int, int],
+        position: tuple[float, float],
+    ) -> None:
+        pointer_id = context.pointer_id_manager.get_allocated_id(identifier)
+        if pointer_id is None:
+            return
+        w, h = context.screen_info.get_host_resolution()
+        is_up = action == AMotionEventAction.UP
+        msg = InjectTouchEventMsg(
+            action=action,
+            pointer_id=pointer_id,
+            position=(int(position[0]), int(position[1]), w, h),
+            pressure=0.0 if is_up else 1.0,
+            action_button=AMotionEventButtons.PRIMARY,
+            buttons=0 if is_up else AMotionEventButtons.PRIMARY,
+        )
+        context.event_bus.emit(Event(EventType.CONTROL_MSG, context, msg))
+
+    def _release(self, context: "Macro", run: _GestureRun) -> None:
+        for identifier, position in zip(run.identifiers, run.positions):
+            if context.pointer_id_manager.get_allocated_id(identifier) is None:
+                continue
+            self._emit(context, AMotionEventAction.UP, identifier, position)
+            context.pointer_id_manager.release(identifier)
+        run.positions = []
+        self._runs.discard(run)
+
+    async def execute(self, context: "Macro") -> None:
+        paths = self._resolve_paths(context)
+        if not paths or any(len(path) < 2 for path in paths):
+            return
+        samplers = [path_sampler(path) for path in paths]
+
+        run = _GestureRun(len(paths))
+        run.positions = [path[0] for path in paths]
+        self._runs.add(run)
+        for identifier, position in zip(run.identifiers, run.positions):
+            if context.pointer_id_manager.allocate(identifier) is None:
+                # 指针 ID 用完了，放开已经按下的手指
+                self._release(context, run)
+                return
+            self._emit(context, AMotionEventAction.DOWN, identifier, position)
+
+        done: asyncio.Future[None] = asyncio.get_running_loop().create_future()
+        motion_clock = MotionClock()
+        subscription_id: int | None = None
+        try:
+            if self.hold > 0:
+                await context.clock.sleep(self.hold)
+            start = context.clock.now()
+
+            def on_tick(now: float) -> bool:
+                if done.done():
+                    return False
+                try:
+                    fraction = 1.0 if self.duration <= 0 else min(1.0, (now - start) / self.duration)
+                    eased = self.easing(fraction)
+                    for finger, sample in enumerate(samplers):
+                        run.positions[finger] = sample(eased)
+                        self._emit(context, AMotionEventAction.MOVE, run.identifiers[finger], run.positions[finger])
+                except Exception as e:
+                    # 异常交给 execute，否则 done 永远不会完成
+                    done.set_exception(e)
+                    return False
+                if fraction >= 1.0:
+                    done.set_result(None)
+                    return False
+                return True
+
+            subscription_id = motion_clock.subscribe(on_tick)
+            await done
+        finally:
+            motion_clock.unsubscribe(subscription_id)
+            self._release(context, run)
+
+    async def cancel(self, context: "Macro") -> None:
+        """取消手势 - 抬起还按着的手指"""
+        for run in list(self._runs):
+            self._release(context, run)
+
+    @staticmethod
+    def parse(args: list[str]) -> tuple[list[list[str]], float, str] | None:
+        """解析 <路径> [+ <路径> ...] <毫秒> [缓动]，见 gesture_path.parse_gesture"""
+        return parse_gesture(args)
+
+
+class PinchCommand(GestureCommand):
+    """双指缩放命令 - 两个手指沿同一直线相向或相背移动"""
+
+    def __init__(
+        self,
+        center: str,
+        start_radius: float,
+        end_radius: float,
+        duration: float,
+        angle: float = 0.0,
+        easing: str = "linear",
+    ):
+        super().__init__([[center, center], [center, center]], duration, easing)
+        self.center = center
+        self.start_radius = start_radius
+        self.end_radius = end_radius
+        self.angle = math.radians(angle)
+
+    def _resolve_paths(self, context: "Macro") -> list[list[tuple[float, float]]]:
+        if self.center == "mouse":
+            cx, cy = context.get_cursor_position()
+        else:
+            cx, cy = (float(v) for v in self.center.split(","))
+        dx, dy = math.cos(self.angle), math.sin(self.angle)
+        return [
+            [
+                (cx + sign * dx * self.start_radius, cy + sign * dy * self.start_radius),
+                (cx + sign * dx * self.end_radius, cy + sign * dy * self.end_radius),
+            ]
+            for sign in (1, -1)
+        ]
+
+    @staticmethod
+    def parse_pinch(args: list[str]) -> "PinchCommand | None":
+        """解析 <中心> <起始半径> <结束半径> <毫秒> [角度] [缓动]"""
+        parsed = parse_pinch(args)
+        if parsed is None:
+            return None
+        return PinchCommand(*parsed)
+
 
 class ReleaseAllCommand(Command):
     """释放所有按键命令"""
@@ -568,7 +756,7 @@ class CommandParser:
             # 处理参数
             if command_type in ["key_press", "key_release", "key_switch"] and args_str:
                 args = [k.strip() for k in args_str.split(",")]
-            elif command_type in ["click", "press", "release", "switch"] and args_str:
+            elif command_type in ["click", "press", "release", "switch", "swipe", "drag", "pinch"] and args_str:
                 args = args_str.split()
             elif command_type == "toggle_group" and args_str:
                 args = [args_str]  # toggle_group 需要保持完整字符串，在工厂中再分割
@@ -591,6 +779,9 @@ class CommandParser:
 class CommandFactory:
     """命令工厂 - 负责创建具体的命令对象"""
 
+    # drag 在移动前长按的时间（秒），超过 Android 的长按阈值
+    DRAG_HOLD = 0.5
+
     @staticmethod
     def create_command(command_type: str, args: list[str]) -> Command | None:
         """根据命令类型和参数创建命令对象"""
@@ -644,6 +835,15 @@ class CommandFactory:
                 return SwitchCommand(args)
             else:
                 return None
+        elif command_type in ("swipe", "drag"):
+            parsed = GestureCommand.parse(args)
+            if parsed is None:
+                return None
+            fingers, duration, easing = parsed
+            hold = CommandFactory.DRAG_HOLD if command_type == "drag" else 0.0
+            return GestureCommand(fingers, duration, easing, hold)
+        elif command_type == "pinch":
+            return PinchCommand.parse_pinch(args)
         elif command_type == "enter_staring":
             return EnterStaringCommand()
         elif command_type == "exit_staring":
@@ -755,6 +955,10 @@ class Macro(BaseWidget):
                 "- press <x,y> [x1,y1] ...: Press at coordinates (DOWN events only)\n"
                 "- release <x,y> [x1,y1] ...: Release at coordinates (UP events only)\n"
                 "- switch <x,y> [x1,y1] ...: Switch at coordinates (toggle between press/release)\n"
+                "- swipe <x,y> <x1,y1> [x2,y2] ... <milliseconds> [easing]: Swipe along a path; use '+' between paths for more fingers\n"
+                "- drag <x,y> <x1,y1> ... <milliseconds> [easing]: Long press, then swipe along a path\n"
+                "- pinch <x,y> <start_radius> <end_radius> <milliseconds> [angle] [easing]: Two-finger pinch around a center\n"
+                "- Easings: linear, ease_in, ease_out, ease_in_out\n"
                 "- toggle_group <command_group_1> | <command_group_2>: Toggle between two command groups (use ';' to separate commands within a group)\n"
                 "- sleep <milliseconds>: Delay execution\n"
                 "- release_all: Release all currently pressed keys\n"
@@ -865,8 +1069,9 @@ class Macro(BaseWidget):
             return True
 
         if self.press_commands:
-            self.current_press_task = asyncio.create_task(
-                self._execute_commands_async(self.press_commands, "press")
+            self.current_press_task = self.tasks.create_task(
+                self._execute_commands_async(self.press_commands, "press"),
+                name="press",
             )
         return True
 
@@ -893,8 +1098,9 @@ class Macro(BaseWidget):
             self.current_release_task.cancel()
 
         # 创建新的 release task
-        self.current_release_task = asyncio.create_task(
-            self._execute_commands_async(self.release_commands, "release")
+        self.current_release_task = self.tasks.create_task(
+            self._execute_commands_async(self.release_commands, "release"),
+            name="release",
         )
         return True
 
@@ -923,7 +1129,7 @@ class Macro(BaseWidget):
             self.current_release_task.cancel()
 
         # 2. 启动新的异步任务执行取消操作
-        asyncio.create_task(self._execute_release_all_async())
+        self.tasks.create_task(self._execute_release_all_async(), name="release-all")
 
     async def _execute_release_all_async(self):
         """异步执行释放所有命令状态的操作"""
@@ -331,7 +331,7 @@ class RepeatedClick(BaseWidget):
             while self._is_clicking:
                 await self._send_click_sequence(w, h, pointer_id)
 
-                await asyncio.sleep(interval - 0.001)  # 剩余时间等待
+                await self.clock.sleep(interval - 0.001)  # 剩余时间等待
 
         except Exception:
             pass
@@ -361,7 +361,7 @@ class RepeatedClick(BaseWidget):
                 await self._send_click_sequence(w, h, pointer_id)
 
                 if i < click_count - 1:  # 最后一次点击后不需要等待
-                    await asyncio.sleep(interval - 0.001)
+                    await self.clock.sleep(interval - 0.001)
 
         except Exception:
             pass
@@ -398,7 +398,7 @@ class RepeatedClick(BaseWidget):
         await self._send_touch_event(
             AMotionEventAction.DOWN, pointer_id, root_width, root_height, 1.0
         )
-        await asyncio.sleep(0.001)  # 短暂延迟确保事件处理
+        await self.clock.sleep(0.001)  # 短暂延迟确保事件处理
         await self._send_touch_event(
             AMotionEventAction.UP, pointer_id, root_width, root_height, 0.0
         )
@@ -437,8 +437,8 @@ class RepeatedClick(BaseWidget):
                 clicks_per_second = max(1, min(clicks_per_second, 100))  # 限制范围1-100
 
                 # 创建新的异步任务
-                self._click_task = asyncio.create_task(
-                    self._long_press_combo_click(clicks_per_second)
+                self._click_task = self.tasks.create_task(
+                    self._long_press_combo_click(clicks_per_second), name="click"
                 )
 
             except ValueError:
@@ -477,8 +477,8 @@ class RepeatedClick(BaseWidget):
                 click_count = max(1, min(click_count, 999))  # 限制范围1-100
 
                 # 创建新的异步任务
-                self._click_task = asyncio.create_task(
-                    self._click_after_button_click(click_count)
+                self._click_task = self.tasks.create_task(
+                    self._click_after_button_click(click_count), name="click"
                 )
 
             except ValueError:
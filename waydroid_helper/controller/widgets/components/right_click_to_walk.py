@@ -1,6 +1,5 @@
 #!/usr/bin/env python3
 import math
-import time
 from enum import Enum
 from gettext import pgettext
 from typing import TYPE_CHECKING, cast
@@ -9,7 +8,7 @@ if TYPE_CHECKING:
     from cairo import Context, Surface
     from gi.repository import Gtk
 
-from gi.repository import GLib, Gdk, Gtk
+from gi.repository import Gdk, Gtk
 
 from waydroid_helper.controller.android.input import (AMotionEventAction,
                                                       AMotionEventButtons)
@@ -151,7 +150,7 @@ class RightClickToWalk(BaseWidget):
         
         self.set_default_keys(default_keys)
  
-        self.event_bus.subscribe(EventType.MOUSE_MOTION, lambda event: (self.on_key_triggered(None, event.data), None)[1])
+        self.event_bus.subscribe(EventType.MOUSE_MOTION, self._on_mouse_motion, subscriber=self)
 
         # 摇杆状态管理
         self._joystick_state: JoystickState = JoystickState.INACTIVE
@@ -491,17 +490,17 @@ class RightClickToWalk(BaseWidget):
     def _start_smooth_move_to_boundary(self):
         """开始平滑移动到边界"""
         if self._move_timer:
-            GLib.source_remove(self._move_timer)
+            self.clock.source_remove(self._move_timer)
         
         self._joystick_state = JoystickState.MOVING
         self._move_steps_count = 0
-        self._move_timer = GLib.timeout_add(
+        self._move_timer = self.clock.timeout_add(
             self._timer_interval, self._update_smooth_move
         )
 
     def _update_smooth_move(self) -> bool:
         """平滑移动的定时器回调"""
-        if self._last_mouse_position is not None and self._should_follow_cursor(time.time()):
+        if self._last_mouse_position is not None and self._should_follow_cursor(self.clock.now()):
             window_center_x, window_center_y = self._get_window_center()
             mouse_x, mouse_y = self._last_mouse_position
             widget_radius = self.width / 2
@@ -555,7 +554,7 @@ class RightClickToWalk(BaseWidget):
         """开始保持计时器"""
         # 清除之前的计时器（如果有）
         if self._hold_timer:
-            GLib.source_remove(self._hold_timer)
+            self.clock.source_remove(self._hold_timer)
             self._hold_timer = None
         
         # 计算保持时间
@@ -566,7 +565,7 @@ class RightClickToWalk(BaseWidget):
         )
         
         # 启动计时器
-        self._hold_timer = GLib.timeout_add(
+        self._hold_timer = self.clock.timeout_add(
             int(self._hold_duration * 1000), 
             self._on_hold_timeout
         )
@@ -588,7 +587,7 @@ class RightClickToWalk(BaseWidget):
         
         # 清除之前的保持计时器（如果有）
         if self._hold_timer:
-            GLib.source_remove(self._hold_timer)
+            self.clock.source_remove(self._hold_timer)
             self._hold_timer = None
         
 
@@ -607,10 +606,10 @@ class RightClickToWalk(BaseWidget):
         
         # 清理定时器
         if self._move_timer:
-            GLib.source_remove(self._move_timer)
+            self.clock.source_remove(self._move_timer)
             self._move_timer = None
         if self._hold_timer:
-            GLib.source_remove(self._hold_timer)
+            self.clock.source_remove(self._hold_timer)
             self._hold_timer = None
         
         # 释放指针ID
@@ -684,6 +683,9 @@ class RightClickToWalk(BaseWidget):
 
         return (px, py)
 
+    def _on_mouse_motion(self, event: "Event[InputEvent]") -> None:
+        self.on_key_triggered(None, event.data)
+
     def on_key_triggered(
         self,
         key_combination: KeyCombination | None = None,
@@ -692,7 +694,7 @@ class RightClickToWalk(BaseWidget):
         if not event or event.position is None:
             return False
 
-        current_time = time.time()
+        current_time = self.clock.now()
 
         # 获取鼠标位置和窗口信息
         mouse_x, mouse_y = event.position
@@ -790,7 +792,7 @@ class RightClickToWalk(BaseWidget):
         if self._joystick_state == JoystickState.INACTIVE:
             return True
 
-        current_time = time.time()
+        current_time = self.clock.now()
         press_duration = current_time - self._key_press_start_time
         self._key_is_currently_pressed = False
         
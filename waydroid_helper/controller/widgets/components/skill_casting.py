@@ -4,11 +4,8 @@
 一个圆形的半透明灰色按钮，支持技能释放操作
 """
 
-import asyncio
 import math
 import re
-import time
-from dataclasses import dataclass
 from enum import Enum
 from gettext import pgettext
 from typing import TYPE_CHECKING, cast
@@ -39,6 +36,8 @@ from waydroid_helper.controller.core import (Event, EventType, KeyCombination,
                                              EventBus, PointerIdManager, KeyRegistry)
 from waydroid_helper.controller.core.control_msg import InjectTouchEventMsg, ScreenInfo
 from waydroid_helper.controller.core.handler.event_handlers import InputEvent
+from waydroid_helper.controller.core.latency_probe import measured_rtt_ms
+from waydroid_helper.controller.core.motion_predictor import MotionPredictor
 from waydroid_helper.controller.widgets.base.base_widget import BaseWidget
 from waydroid_helper.controller.widgets.config import (
     create_action_config,
@@ -68,17 +67,14 @@ class CastTiming(Enum):
     MANUAL = "manual"  # 手动释放
 
 
-@dataclass
-class SkillEvent:
-    """技能事件数据类"""
+class SkillInput(Enum):
+    """状态机输入"""
 
-    type: str  # "key_press", "key_release", "mouse_motion", "cancel_casting"
-    data: dict
-    timestamp: float = None
-
-    def __post_init__(self):
-        if self.timestamp is None:
-            self.timestamp = time.time()
+    KEY_PRESS = "key_press"
+    KEY_RELEASE = "key_release"
+    MOUSE_MOTION = "mouse_motion"
+    CANCEL = "cancel_casting"
+    MOVE_DONE = "move_done"  # 平滑移动结束
 
 
 @Editable
@@ -133,6 +129,8 @@ class SkillCasting(BaseWidget):
     APPLY_CENTER_CONFIG_KEY = "skill_apply_center"
     MOVE_INTERVAL_MS_CONFIG_KEY = "skill_move_interval_ms"
     MOVE_STEPS_CONFIG_KEY = "skill_move_steps"
+    PREDICTION_AUTO_CONFIG_KEY = "prediction_auto"
+    PREDICTION_MS_CONFIG_KEY = "prediction_ms"
     VERTICAL_SCALE_RATIO = 0.745
     SETTINGS_PANEL_AUTO_HIDE = False
 
@@ -200,16 +198,18 @@ class SkillCasting(BaseWidget):
             key_registry=key_registry,
         )
 
-        # 异步状态管理
+        # 状态机
         self._skill_state: SkillState = SkillState.INACTIVE
         self._current_position: tuple[float, float] = (x + width / 2, y + height / 2)
         self._target_position: tuple[float, float] = (x + width / 2, y + height / 2)
         self.is_reentrant: bool = True
 
-        # 异步任务管理
-        self._current_task: asyncio.Task | None = None
-        self._event_queue: asyncio.Queue = asyncio.Queue()
-        self._event_processor_task: asyncio.Task | None = None
+        # 平滑移动的定时器和进度
+        self._move_source_id: int | None = None
+        self._move_from: tuple[float, float] = self._current_position
+        self._move_target: tuple[float, float] = self._current_position
+        self._move_step: int = 0
+        self._cast_timing: str = CastTiming.ON_RELEASE.value
 
         # 技能释放控制标志
         self._target_locked: bool = False  # 是否锁定目标位置（所有模式共用）
@@ -225,6 +225,7 @@ class SkillCasting(BaseWidget):
         # 平滑移动系统参数
         self._move_interval: float = 0.02  # 20ms，转换为秒
         self._move_steps_total: int = 6
+        self._predictor = MotionPredictor(alpha=0.6, beta=0.2, latency_source=measured_rtt_ms)
 
         # 圆形映射参数（像素值）
         # self.circle_radius: int = 200  # 圆半径，单位像素
@@ -250,8 +251,7 @@ class SkillCasting(BaseWidget):
         # 监听选中状态变化，用于圆形绘制通知
         self.connect("notify::is-selected", self._on_selection_changed)
 
-        # 启动异步事件处理器
-        self._start_event_processor()
+        self._cast_timing = str(self.get_config_value("cast_timing"))
 
         # 订阅事件总线
         self.event_bus.subscribe(EventType.MOUSE_MOTION, self._on_mouse_motion, subscriber=self)
@@ -273,38 +273,41 @@ class SkillCasting(BaseWidget):
         self.screen_info = ScreenInfo()
         self._emit_overlay_event("register")
 
-    def _start_event_processor(self):
-        """启动异步事件处理器"""
-        if self._event_processor_task is None or self._event_processor_task.done():
-            self._event_processor_task = asyncio.create_task(self._process_events())
-
-    async def _process_events(self):
-        """异步事件处理器主循环"""
-        try:
-            while True:
-                # 等待事件
-                event = await self._event_queue.get()
-                await self._handle_event(event)
-                self._event_queue.task_done()
-        except:
-            pass
+    # 状态转移表：(状态, 输入) -> 动作；表中没有的组合不做任何事
+    TRANSITIONS: dict[tuple[SkillState, SkillInput], str] = {
+        (SkillState.INACTIVE, SkillInput.KEY_PRESS): "_act_activate",
+        (SkillState.LOCKED, SkillInput.KEY_PRESS): "_act_release",
+        (SkillState.MOVING, SkillInput.KEY_RELEASE): "_act_mark_released",
+        (SkillState.ACTIVE, SkillInput.KEY_RELEASE): "_act_release_on_key_up",
+        (SkillState.ACTIVE, SkillInput.MOUSE_MOTION): "_act_follow",
+        (SkillState.LOCKED, SkillInput.MOUSE_MOTION): "_act_follow",
+        (SkillState.MOVING, SkillInput.CANCEL): "_act_defer_cancel",
+        (SkillState.ACTIVE, SkillInput.CANCEL): "_act_cancel",
+        (SkillState.LOCKED, SkillInput.CANCEL): "_act_cancel",
+        (SkillState.CANCELING, SkillInput.CANCEL): "_act_cancel",
+        (SkillState.MOVING, SkillInput.MOVE_DONE): "_act_arrived",
+        (SkillState.CANCELING, SkillInput.MOVE_DONE): "_act_release",
+    }
+
+    def _dispatch(self, skill_input: SkillInput, data: dict | None = None) -> None:
+        """
+        在输入到达时同步执行状态转移
 
-    async def _handle_event(self, event: SkillEvent):
-        """处理单个事件"""
+        Only the smooth moves (MOVING, CANCELING) take time; they run on a
+        clock timer and report back with MOVE_DONE, so everything else
+        happens before the input handler returns.
+        """
+        action = self.TRANSITIONS.get((self._skill_state, skill_input))
+        if action is None:
+            return
         try:
-            if event.type == "key_press":
-                await self._handle_key_press(event)
-            elif event.type == "key_release":
-                await self._handle_key_release(event)
-            elif event.type == "mouse_motion":
-                await self._handle_mouse_motion_async(event)
-            elif event.type == "cancel_casting":
-                await self._handle_cancel_casting_async(event)
-        except:
-            pass
+            getattr(self, action)(data or {})
+        except Exception as e:
+            logger.error(f"Skill casting {action} failed: {e}")
+            self._release_skill()
 
     def _on_mouse_motion(self, event):
-        """鼠标移动事件回调 - 将事件放入队列"""
+        """鼠标移动事件回调"""
         # 窗口发送的 MOUSE_MOTION 事件包含 InputEvent 对象
         if hasattr(event, "data") and hasattr(event.data, "position"):
             # 这是 InputEvent 对象
@@ -318,111 +321,29 @@ class SkillCasting(BaseWidget):
             position = event.data["position"]
         else:
             position = self.screen_info.get_cursor_position()
-            if position is None:
-                return
-
-        skill_event = SkillEvent(
-            type="mouse_motion", data={"position": position, "timestamp": time.time()}
-        )
-
-        # 非阻塞方式放入队列
-        try:
-            self._event_queue.put_nowait(skill_event)
-        except:
-            pass
-
-    def _on_cancel_casting(self, event):
-        """取消施法事件回调 - 将事件放入队列"""
-        skill_event = SkillEvent(
-            type="cancel_casting", data=event.data if hasattr(event, "data") else event
-        )
-
-        # 非阻塞方式放入队列
-        try:
-            self._event_queue.put_nowait(skill_event)
-        except:
-            pass
-
-    async def _handle_key_press(self, event: SkillEvent):
-        """异步处理按键按下事件"""
-        if self._skill_state == SkillState.INACTIVE:
-            # 首次激活
-            await self._activate_skill()
-        elif self._skill_state == SkillState.LOCKED:
-            # 手动释放模式的第二次按键
-            await self._release_skill()
-
-    async def _handle_key_release(self, event: SkillEvent):
-        """异步处理按键释放事件"""
-        if self._skill_state == SkillState.INACTIVE:
+        if not position:
             return
+        self._on_motion(position, self.clock.now())
 
-        # 取消施法状态下不响应按键弹起
-        if self._skill_state == SkillState.CANCELING:
-            return
+    def _on_motion(self, position: tuple[float, float], timestamp: float) -> None:
+        self._mouse_x, self._mouse_y = position
+        predicted = self._predictor.update(self._mouse_x, self._mouse_y, timestamp)
+        self._dispatch(SkillInput.MOUSE_MOTION, {"predicted": predicted})
 
-        # 根据施法时机决定处理方式
-        if self.get_config_value("cast_timing") == CastTiming.ON_RELEASE.value:
-            if self._skill_state == SkillState.MOVING:
-                # 正在移动中，设置标志表示按键已释放
-                self._key_released_during_moving = True
-            elif self._skill_state == SkillState.ACTIVE:
-                # 已到达目标，立即发送UP事件并重置
-                await self._release_skill()
-
-    async def _handle_mouse_motion_async(self, event: SkillEvent):
-        """异步处理鼠标移动事件"""
-        if not event.data.get("position"):
-            return
-
-        self._mouse_x, self._mouse_y = event.data["position"]
-        mapped_target = self._map_circle_to_circle(self._mouse_x, self._mouse_y)
-
-        if self._skill_state == SkillState.INACTIVE:
-            # 未激活状态下不处理鼠标移动
-            return
-        elif self._skill_state == SkillState.MOVING:
-            # 移动中忽略鼠标移动（目标已锁定）
-            return
-        elif self._skill_state == SkillState.ACTIVE:
-            # 激活状态：更新目标位置并瞬移
-            await self._instant_move_to_target(mapped_target)
-        elif self._skill_state == SkillState.LOCKED:
-            # 锁定状态：鼠标移动，瞬移到新目标位置
-            await self._instant_move_to_target(mapped_target)
-
-    async def _handle_cancel_casting_async(self, event: SkillEvent):
-        """异步处理取消施法事件"""
-        if self._skill_state == SkillState.INACTIVE:
-            return
-
-        # 从事件中获取取消施法的目标位置
-        event_data = event.data
+    def _on_cancel_casting(self, event):
+        """取消施法事件回调"""
+        event_data = event.data if hasattr(event, "data") else event
         if (
             not isinstance(event_data, dict)
             or "x" not in event_data
             or "y" not in event_data
         ):
             return
+        self._dispatch(SkillInput.CANCEL, {"position": (event_data["x"], event_data["y"])})
 
-        cancel_x = event_data["x"]
-        cancel_y = event_data["y"]
-        self._cancel_target_position = (cancel_x, cancel_y)
+    # 状态机动作
 
-        if self._skill_state == SkillState.MOVING:
-            # 当前正在移动中，等待移动完成后再执行取消流程
-            pass
-            # 不取消当前任务，让它自然完成，然后在 _skill_casting_flow 中处理取消
-        else:
-            # 当前不在移动状态，立即开始取消施法移动
-            # 取消当前任务
-            if self._current_task and not self._current_task.done():
-                self._current_task.cancel()
-
-            # 开始取消施法移动
-            self._current_task = asyncio.create_task(self._cancel_casting_move())
-
-    async def _activate_skill(self):
+    def _act_activate(self, data: dict) -> None:
         """激活技能"""
         # 将鼠标位置映射到虚拟摇杆位置
         mapped_target = self._map_circle_to_circle(self._mouse_x, self._mouse_y)
@@ -430,6 +351,7 @@ class SkillCasting(BaseWidget):
         # 设置目标位置并锁定
         self._target_position = mapped_target
         self._target_locked = True
+        self._predictor.reset()
 
         # 分配指针ID并发送DOWN事件
         pointer_id = self.pointer_id_manager.allocate(self)
@@ -439,109 +361,125 @@ class SkillCasting(BaseWidget):
         self._current_position = (self.center_x, self.center_y)
         self._emit_touch_event(AMotionEventAction.DOWN, position=self._current_position)
 
-        # 开始技能流程
-        self._current_task = asyncio.create_task(self._skill_casting_flow())
+        # 开始移动
+        self._skill_state = SkillState.MOVING
+        self._start_move(self._target_position)
 
-    async def _skill_casting_flow(self):
-        """技能释放主流程"""
-        try:
-            # 开始移动
-            self._skill_state = SkillState.MOVING
-            await self._smooth_move_to_target(self._target_position)
-
-            # 移动完成后同步当前鼠标位置，避免等待新移动事件
-            mapped_target = self._map_circle_to_circle(self._mouse_x, self._mouse_y)
-            await self._instant_move_to_target(mapped_target)
-
-            # 移动完成后，检查是否有取消请求
-            if self._cancel_target_position is not None:
-                # 有待处理的取消事件，开始取消施法移动
-                await self._cancel_casting_move()
-                return
+    def _act_arrived(self, data: dict) -> None:
+        """移动到目标后根据施法时机决定下一个状态"""
+        # 移动完成后同步当前鼠标位置，避免等待新移动事件
+        mapped_target = self._map_circle_to_circle(self._mouse_x, self._mouse_y)
+        self._instant_move_to_target(mapped_target)
 
-            # 根据施法时机处理
-            if self.get_config_value("cast_timing") == CastTiming.IMMEDIATE.value:
-                # 立即释放模式：移动完成后立即发送UP事件并重置
-                await self._release_skill()
-            elif self.get_config_value("cast_timing") == CastTiming.MANUAL.value:
-                # 手动释放模式：进入锁定状态，等待第二次按键
-                self._skill_state = SkillState.LOCKED
-                self._target_locked = False  # 解锁目标位置，允许瞬移
-            else:  # ON_RELEASE
-                # ON_RELEASE模式：检查是否在移动过程中按键已释放
-                if self._key_released_during_moving:
-                    # 移动过程中按键已释放，立即发送UP事件并重置
-                    await self._release_skill()
-                else:
-                    # 按键未释放，进入激活状态，等待按键松开
-                    self._skill_state = SkillState.ACTIVE
-                    self._target_locked = False  # 解锁目标位置，允许瞬移
+        # 移动过程中收到了取消请求
+        if self._cancel_target_position is not None:
+            self._start_cancel_move()
+            return
 
-        except asyncio.CancelledError:
-            # 被取消时的处理
-            await self._release_skill()
-        except Exception as e:
-            await self._release_skill()
+        if self._cast_timing == CastTiming.IMMEDIATE.value:
+            # 立即释放模式：移动完成后立即发送UP事件并重置
+            self._release_skill()
+        elif self._cast_timing == CastTiming.MANUAL.value:
+            # 手动释放模式：进入锁定状态，等待第二次按键
+            self._skill_state = SkillState.LOCKED
+            self._target_locked = False  # 解锁目标位置，允许瞬移
+        elif self._key_released_during_moving:
+            # ON_RELEASE模式：移动过程中按键已释放，立即发送UP事件并重置
+            self._release_skill()
+        else:
+            # 按键未释放，进入激活状态，等待按键松开
+            self._skill_state = SkillState.ACTIVE
+            self._target_locked = False
 
-    async def _cancel_casting_move(self):
-        """取消施法的平滑移动"""
-        if self._cancel_target_position is None:
-            return
+    def _act_mark_released(self, data: dict) -> None:
+        # 正在移动中，记下按键已释放，到达目标后再释放
+        if self._cast_timing == CastTiming.ON_RELEASE.value:
+            self._key_released_during_moving = True
 
-        try:
-            # 设置目标位置并开始移动
-            self._target_position = self._cancel_target_position
-            self._skill_state = SkillState.CANCELING
-            self._target_locked = True  # 锁定目标，不允许中断
+    def _act_release_on_key_up(self, data: dict) -> None:
+        if self._cast_timing == CastTiming.ON_RELEASE.value:
+            self._release_skill()
 
-            # 开始平滑移动
-            await self._smooth_move_to_target(self._cancel_target_position)
+    def _act_follow(self, data: dict) -> None:
+        # 映射到施法圆内，预测超出的部分会被圆的半径截断
+        self._instant_move_to_target(self._map_circle_to_circle(*data["predicted"]))
 
-            # 移动完成，发送UP事件并重置
-            await self._release_skill()
+    def _act_defer_cancel(self, data: dict) -> None:
+        # 移动中不打断，到达目标后再执行取消
+        self._cancel_target_position = data["position"]
 
-        except asyncio.CancelledError:
-            await self._release_skill()
-        except Exception:
-            await self._release_skill()
+    def _act_cancel(self, data: dict) -> None:
+        self._cancel_target_position = data["position"]
+        self._start_cancel_move()
 
-    async def _smooth_move_to_target(self, target: tuple[float, float]):
-        """异步平滑移动到目标位置"""
-        start_pos = self._current_position
-        steps = self._move_steps_total
+    def _act_release(self, data: dict) -> None:
+        self._release_skill()
 
-        for step in range(1, steps + 1):
-            # 计算当前位置
-            progress = step / steps
-            current_x = start_pos[0] + (target[0] - start_pos[0]) * progress
-            current_y = start_pos[1] + (target[1] - start_pos[1]) * progress
+    def _start_cancel_move(self) -> None:
+        """平滑移动到取消施法的位置，到达后释放"""
+        assert self._cancel_target_position is not None
+        self._target_position = self._cancel_target_position
+        self._skill_state = SkillState.CANCELING
+        self._target_locked = True  # 锁定目标，不允许中断
+        self._start_move(self._cancel_target_position)
 
-            self._current_position = (current_x, current_y)
-            self._emit_touch_event(AMotionEventAction.MOVE)
+    # 平滑移动
 
-            # 等待间隔
-            await asyncio.sleep(self._move_interval)
+    def _start_move(self, target: tuple[float, float]) -> None:
+        """
+        平滑移动到目标位置
 
-            # 检查是否被取消
-            if self._skill_state == SkillState.INACTIVE:
-                return
+        The first step is sent at once, the rest one per move interval on
+        a clock timer; MOVE_DONE is dispatched one interval after the last
+        step, the same timing the awaited loop had.
+        """
+        self._stop_move()
+        self._move_from = self._current_position
+        self._move_target = target
+        self._move_step = 0
+        if self._move_tick():
+            self._move_source_id = self.clock.timeout_add(
+                max(1, int(round(self._move_interval * 1000))), self._move_tick
+            )
 
-        # 移动完成
-        self._current_position = target
+    def _stop_move(self) -> None:
+        if self._move_source_id is not None:
+            self.clock.source_remove(self._move_source_id)
+            self._move_source_id = None
 
-    async def _instant_move_to_target(self, target: tuple[float, float]):
+    def _move_tick(self) -> bool:
+        self._move_step += 1
+        steps = self._move_steps_total
+        if self._move_step > steps:
+            self._move_source_id = None
+            self._current_position = self._move_target
+            self._dispatch(SkillInput.MOVE_DONE)
+            return False
+
+        progress = self._move_step / steps
+        start_x, start_y = self._move_from
+        target_x, target_y = self._move_target
+        self._current_position = (
+            start_x + (target_x - start_x) * progress,
+            start_y + (target_y - start_y) * progress,
+        )
+        self._emit_touch_event(AMotionEventAction.MOVE)
+        return True
+
+    def _instant_move_to_target(self, target: tuple[float, float]):
         """瞬间移动到目标位置"""
         self._current_position = target
         self._target_position = target
         self._emit_touch_event(AMotionEventAction.MOVE)
 
-    async def _release_skill(self):
+    def _release_skill(self):
         """释放技能"""
         self._emit_touch_event(AMotionEventAction.UP)
-        await self._reset_skill()
+        self._reset_skill()
 
-    async def _reset_skill(self):
-        """异步重置技能状态"""
+    def _reset_skill(self):
+        """重置技能状态"""
+        self._stop_move()
         self._skill_state = SkillState.INACTIVE
         self._current_position = (self.center_x, self.center_y)
         self._target_locked = False
@@ -550,11 +488,6 @@ class SkillCasting(BaseWidget):
         # 清理取消施法相关状态
         self._cancel_target_position = None
 
-        # 取消当前任务
-        if self._current_task and not self._current_task.done():
-            self._current_task.cancel()
-            self._current_task = None
-
         # 释放指针ID
         self.pointer_id_manager.release(self)
 
@@ -1015,8 +948,32 @@ class SkillCasting(BaseWidget):
             ),
         )
 
+        prediction_auto_config = create_switch_config(
+            key=self.PREDICTION_AUTO_CONFIG_KEY,
+            label=pgettext("Controller Widgets", "Automatic Motion Prediction"),
+            value=False,
+            description=pgettext(
+                "Controller Widgets",
+                "Predicts ahead by the measured latency of the device connection. Uses the fixed time below until the latency is measured",
+            ),
+        )
+        prediction_config = create_slider_config(
+            key=self.PREDICTION_MS_CONFIG_KEY,
+            label=pgettext("Controller Widgets", "Motion Prediction (ms)"),
+            value=0,
+            min_value=0,
+            max_value=50,
+            step=1,
+            description=pgettext(
+                "Controller Widgets",
+                "Extrapolates the cursor ahead by this time while aiming a skill to offset input latency when automatic prediction is off or has no measurement yet. 0 disables prediction",
+            ),
+        )
+
         self.add_config_item(move_interval_config)
         self.add_config_item(move_steps_config)
+        self.add_config_item(prediction_auto_config)
+        self.add_config_item(prediction_config)
         self.add_config_item(circle_radius_config)
         self.add_config_item(cast_timing_config)
         self.add_config_item(self.cancel_button_config)
@@ -1068,6 +1025,12 @@ class SkillCasting(BaseWidget):
         self.add_config_change_callback(
             self.MOVE_STEPS_CONFIG_KEY, self._on_move_steps_changed
         )
+        self.add_config_change_callback(
+            self.PREDICTION_AUTO_CONFIG_KEY, self._on_prediction_auto_changed
+        )
+        self.add_config_change_callback(
+            self.PREDICTION_MS_CONFIG_KEY, self._on_prediction_changed
+        )
         self.add_config_change_callback(
             "enable_cancel_button", self._on_cancel_button_config_changed
         )
@@ -1156,6 +1119,8 @@ class SkillCasting(BaseWidget):
             self.get_config_value(self.MOVE_INTERVAL_MS_CONFIG_KEY)
         )
         self._apply_move_steps(self.get_config_value(self.MOVE_STEPS_CONFIG_KEY))
+        self._predictor.auto = bool(self.get_config_value(self.PREDICTION_AUTO_CONFIG_KEY))
+        self._apply_prediction_ms(self.get_config_value(self.PREDICTION_MS_CONFIG_KEY))
 
         self._sync_center_inputs()
         self.get_config_manager().connect(
@@ -1181,6 +1146,18 @@ class SkillCasting(BaseWidget):
         except (TypeError, ValueError):
             pass
 
+    def _apply_prediction_ms(self, value: object) -> None:
+        try:
+            self._predictor.lead_time = max(0.0, float(value)) / 1000.0
+        except (TypeError, ValueError):
+            self._predictor.lead_time = 0.0
+
+    def _on_prediction_auto_changed(self, key: str, value: bool, restoring: bool) -> None:
+        self._predictor.auto = bool(value)
+
+    def _on_prediction_changed(self, key: str, value: float, restoring: bool) -> None:
+        self._apply_prediction_ms(value)
+
     def _on_move_interval_changed(self, key: str, value: float, restoring: bool) -> None:
         self._apply_move_interval_ms(value)
 
@@ -1299,7 +1276,7 @@ class SkillCasting(BaseWidget):
         target_x = widget_center_x + math.cos(angle) * widget_radius
         target_y = widget_center_y + math.sin(angle) * widget_radius
         self._target_position = (target_x, target_y)
-        asyncio.create_task(self._instant_move_to_target(self._target_position))
+        self._instant_move_to_target(self._target_position)
 
     def _on_set_diag_point_clicked(
         self, key: str, value: bool, restoring: bool, diag_label: str
@@ -1320,11 +1297,7 @@ class SkillCasting(BaseWidget):
 
     def _on_cast_timing_changed(self, key: str, value: str, restoring:bool) -> None:
         """处理施法时机配置变更"""
-        try:
-            # self.cast_timing = str(value)
-            pass
-        except (ValueError, TypeError):
-            pass
+        self._cast_timing = str(value)
 
     def _on_cancel_button_config_changed(self, key: str, value: bool, restoring:bool) -> None:
         """处理取消施法按钮配置变更"""
@@ -1414,6 +1387,7 @@ class SkillCasting(BaseWidget):
                         [
                             self.MOVE_INTERVAL_MS_CONFIG_KEY,
                             self.MOVE_STEPS_CONFIG_KEY,
+                            self.PREDICTION_MS_CONFIG_KEY,
                         ],
                         expanded=False,
                     ),
@@ -1957,18 +1931,8 @@ class SkillCasting(BaseWidget):
         )
         self.cancel_button_widget["widget"] = None
 
-    def __del__(self):
-        """析构时清理取消按钮和异步任务"""
-        # if self._cancel_button_widget is not None:
-        #     self._disable_cancel_button()
-
-        # 取消异步任务
-        if self._current_task and not self._current_task.done():
-            self._current_task.cancel()
-        if self._event_processor_task and not self._event_processor_task.done():
-            self._event_processor_task.cancel()
-
     def on_delete(self):
+        self._stop_move()
         self._emit_overlay_event("unregister")
         super().on_delete()
 
@@ -2521,7 +2485,7 @@ class SkillCasting(BaseWidget):
         key_combination: KeyCombination | None = None,
         event: "InputEvent | None" = None,
     ):
-        """按键触发事件处理 - 将事件放入异步队列"""
+        """按键触发事件处理 - 直接驱动状态机"""
         if not event or not event.event_type:
             return False
 
@@ -2539,23 +2503,9 @@ class SkillCasting(BaseWidget):
         if is_mouse_motion:
             if not event.position:
                 return False
-            self._mouse_x, self._mouse_y = event.position
-
-        # 将事件放入异步队列
-        skill_event = SkillEvent(
-            type=event.event_type,
-            data={
-                "key_combination": key_combination,
-                "position": event.position,
-                "timestamp": time.time(),
-            },
-        )
-
-        # 非阻塞方式放入队列
-        try:
-            self._event_queue.put_nowait(skill_event)
-        except asyncio.QueueFull:
-            pass
+            self._on_motion(event.position, self.clock.now())
+        else:
+            self._dispatch(SkillInput.KEY_PRESS)
 
         return True
 
@@ -2564,19 +2514,8 @@ class SkillCasting(BaseWidget):
         key_combination: KeyCombination | None = None,
         event: "InputEvent | None" = None,
     ):
-        """按键释放事件处理 - 将事件放入异步队列"""
-        # 将事件放入异步队列
-        skill_event = SkillEvent(
-            type="key_release",
-            data={"key_combination": key_combination, "timestamp": time.time()},
-        )
-
-        # 非阻塞方式放入队列
-        try:
-            self._event_queue.put_nowait(skill_event)
-        except asyncio.QueueFull:
-            pass
-
+        """按键释放事件处理 - 直接驱动状态机"""
+        self._dispatch(SkillInput.KEY_RELEASE)
         return True
 
     def get_editable_regions(self) -> list["EditableRegion"]:
@@ -7,8 +7,9 @@
 import gi
 
 gi.require_version('Gtk', '4.0')
-from gi.repository import Gdk, GLib, Gtk
+from gi.repository import Gdk, Gtk
 
+from waydroid_helper.controller.core.clock import get_clock
 from waydroid_helper.controller.core.handler import KeyMappingManager
 from waydroid_helper.controller.core.key_system import (Key, KeyCombination)
 from waydroid_helper.util.log import logger
@@ -261,7 +262,7 @@ class EditableDecorator(WidgetDecorator):
                 self._wrapped_widget.grab_focus()
             return False
             
-        GLib.timeout_add(10, check_focus)
+        get_clock().timeout_add(10, check_focus)
         
         # 重绘组件
         self._wrapped_widget.queue_draw()
@@ -299,7 +300,7 @@ class EditableDecorator(WidgetDecorator):
                 self._wrapped_widget.grab_focus()
             return False
             
-        GLib.timeout_add(10, check_focus)
+        get_clock().timeout_add(10, check_focus)
         
         # 重绘组件
         self._wrapped_widget.queue_draw()
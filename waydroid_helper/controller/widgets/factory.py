@@ -1,7 +1,7 @@
 #!/usr/bin/env python3
 """
 动态组件工厂
-自动扫描components目录，发现和注册widget类
+从静态清单注册widget类型，在第一次使用时才导入组件模块
 """
 
 from __future__ import annotations
@@ -9,7 +9,8 @@ from __future__ import annotations
 import importlib
 import inspect
 import pkgutil
-from typing import TYPE_CHECKING, Any
+from gettext import pgettext
+from typing import TYPE_CHECKING, Any, NamedTuple
 
 from waydroid_helper.util.log import logger
 
@@ -18,13 +19,103 @@ if TYPE_CHECKING:
 
     from waydroid_helper.controller.widgets.base import BaseWidget
 
+COMPONENTS_PACKAGE = "waydroid_helper.controller.widgets.components"
+
+class WidgetManifestEntry(NamedTuple):
+    """静态组件清单条目"""
+
+    module: str
+    class_name: str
+    name: str
+    allow_context_menu_creation: bool = True
+
+
+# 组件清单，构建菜单时无需导入组件模块，模块在第一次创建组件时才导入。
+# "Refresh widgets" still scans the components directory for modules not listed here.
+# Names and menu flags must match the classes' WIDGET_NAME / ALLOW_CONTEXT_MENU_CREATION,
+# which tests/test_widget_manifest.py checks.
+WIDGET_MANIFEST: dict[str, WidgetManifestEntry] = {
+    "aim": WidgetManifestEntry(
+        "aim", "Aim", pgettext("Controller Widgets", "Aim")
+    ),
+    "cancelcasting": WidgetManifestEntry(
+        "cancel_casting",
+        "CancelCasting",
+        pgettext("Controller Widgets", "Cancel Casting"),
+        allow_context_menu_creation=False,
+    ),
+    "circletiltradiuscalibration": WidgetManifestEntry(
+        "circle_tilt_radius_calibration",
+        "CircleTiltRadiusCalibration",
+        pgettext("Controller Widgets", "Circle Tilt / Radius Calibration"),
+    ),
+    "directionalpad": WidgetManifestEntry(
+        "directional_pad",
+        "DirectionalPad",
+        pgettext("Controller Widgets", "Directional Pad"),
+    ),
+    "fire": WidgetManifestEntry(
+        "fire", "Fire", pgettext("Controller Widgets", "Fire")
+    ),
+    "macro": WidgetManifestEntry(
+        "macro", "Macro", pgettext("Controller Widgets", "Macro")
+    ),
+    "repeatedclick": WidgetManifestEntry(
+        "repeated_click",
+        "RepeatedClick",
+        pgettext("Controller Widgets", "Repeated Click"),
+    ),
+    "rightclicktowalk": WidgetManifestEntry(
+        "right_click_to_walk",
+        "RightClickToWalk",
+        pgettext("Controller Widgets", "Right Click to Walk"),
+    ),
+    "singleclick": WidgetManifestEntry(
+        "single_click",
+        "SingleClick",
+        pgettext("Controller Widgets", "Single Click"),
+    ),
+    "skillcasting": WidgetManifestEntry(
+        "skill_casting",
+        "SkillCasting",
+        pgettext("Controller Widgets", "Skill Casting"),
+    ),
+}
+
+
 class WidgetFactory:
     """动态组件工厂类"""
     
     def __init__(self):
         self.widget_classes: dict[str, type["BaseWidget"]] = {}
         self.widget_metadata: dict[str, dict[str, Any]] = {}
-        self._discover_widgets()
+        self._manifest: dict[str, WidgetManifestEntry] = {}
+        self._register_manifest()
+
+    def _register_manifest(self):
+        """从静态清单注册组件类型，不导入任何组件模块"""
+        for widget_type, entry in WIDGET_MANIFEST.items():
+            self._manifest[widget_type] = entry
+            self.widget_metadata[widget_type] = {
+                'name': entry.name,
+                'description': '',
+                'class_name': entry.class_name,
+                'module': f"{COMPONENTS_PACKAGE}.{entry.module}",
+                'allow_context_menu_creation': entry.allow_context_menu_creation,
+            }
+
+    def get_widget_class(self, widget_type: str) -> type["BaseWidget"] | None:
+        """获取组件类，清单中的组件在此时才导入"""
+        widget_class = self.widget_classes.get(widget_type)
+        if widget_class is not None:
+            return widget_class
+
+        entry = self._manifest.get(widget_type)
+        if entry is None:
+            return None
+
+        self._load_widget_from_module(entry.module)
+        return self.widget_classes.get(widget_type)
     
     def _discover_widgets(self):
         """动态发现组件目录中的所有widget类"""
@@ -46,7 +137,7 @@ class WidgetFactory:
         """从模块中加载widget类"""
         try:
             # 动态导入模块
-            module_path = f"waydroid_helper.controller.widgets.components.{module_name}"
+            module_path = f"{COMPONENTS_PACKAGE}.{module_name}"
             module = importlib.import_module(module_path)
             
             # 查找模块中的widget类
@@ -86,7 +177,8 @@ class WidgetFactory:
             'name': getattr(widget_class, '__doc__', widget_class.__name__).split('\n')[0] if widget_class.__doc__ else widget_class.__name__,
             'description': widget_class.__doc__ or '',
             'class_name': widget_class.__name__,
-            'module': widget_class.__module__
+            'module': widget_class.__module__,
+            'allow_context_menu_creation': getattr(widget_class, 'ALLOW_CONTEXT_MENU_CREATION', True),
         }
         
         # 尝试从类中提取更多元数据
@@ -99,12 +191,11 @@ class WidgetFactory:
     
     def create_widget(self, widget_type: str, **kwargs) -> "BaseWidget" | None:
         """创建指定类型的组件"""
-        if widget_type not in self.widget_classes:
-            available = list(self.widget_classes.keys())
+        widget_class = self.get_widget_class(widget_type)
+        if widget_class is None:
+            available = self.get_available_types()
             raise ValueError(f"Unsupported widget type: {widget_type}. Available types: {available}")
         
-        widget_class = self.widget_classes[widget_type]
-        
         try:
             widget = widget_class(**kwargs)
             return widget
@@ -115,7 +206,7 @@ class WidgetFactory:
     
     def get_available_types(self) -> list[str]:
         """获取所有可用的组件类型"""
-        return list(self.widget_classes.keys())
+        return list(self.widget_metadata.keys())
     
     def get_widget_metadata(self, widget_type: str):
         """获取组件元数据"""
@@ -130,15 +221,16 @@ class WidgetFactory:
     
     def unregister_widget_type(self, name: str):
         """注销组件类型"""
-        if name in self.widget_classes:
-            del self.widget_classes[name]
-            if name in self.widget_metadata:
-                del self.widget_metadata[name]
+        self.widget_classes.pop(name, None)
+        self.widget_metadata.pop(name, None)
+        self._manifest.pop(name, None)
     
     def reload_widgets(self):
         """重新加载所有组件"""
         self.widget_classes.clear()
         self.widget_metadata.clear()
+        self._manifest.clear()
+        self._register_manifest()
         self._discover_widgets()
     
     def print_discovered_widgets(self):
@@ -17,7 +17,6 @@ from gi.repository import Adw, GObject, Gtk
 
 from waydroid_helper.util import Task, logger, template
 from waydroid_helper.waydroid import Waydroid, WaydroidState
-from waydroid_helper.instance_detail_page import InstanceDetailPage
 
 @template(resource_path="/com/jaoushingan/WaydroidHelper/ui/GeneralPage.ui")
 class GeneralPage(Gtk.Box):
@@ -99,6 +98,9 @@ class GeneralPage(Gtk.Box):
             existing_page = self._navigation_view.find_page(detail_page_tag)
 
             if existing_page is None:
+                # Imported on first use, it pulls in the settings, extension and key mapping pages
+                from waydroid_helper.instance_detail_page import InstanceDetailPage
+
                 # Create new detail page - page instances will be created internally
                 detail_page = InstanceDetailPage(
                     self.waydroid,
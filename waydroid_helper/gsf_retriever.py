@@ -9,6 +9,7 @@ import asyncio
 from typing import TYPE_CHECKING
 
 from waydroid_helper.util.log import logger
+from waydroid_helper.util.privileged import PrivilegedHelper
 from waydroid_helper.util.subprocess_manager import SubprocessManager
 
 gi.require_version("Gtk", "4.0")
@@ -26,6 +27,8 @@ if TYPE_CHECKING:
     from waydroid_helper.waydroid import Waydroid
 
 class GSFIDRetrieverDialog(dialog.Dialog):
+    # Seconds waydroid-cli waits for GMS to write android_id
+    ANDROID_ID_TIMEOUT = 30
 
     def __init__(self, parent_window, waydroid_instance: "Waydroid"):
         super().__init__(
@@ -255,7 +258,10 @@ class GSFIDRetrieverDialog(dialog.Dialog):
         try:
             await self.waydroid.start_session()
             success = await wait_for_state(
-                self.waydroid, SessionState.RUNNING, timeout=30.0
+                self.waydroid,
+                SessionState.RUNNING,
+                timeout=30.0,
+                notifier=self.waydroid.state_notifier,
             )
 
             if not success:
@@ -268,6 +274,7 @@ class GSFIDRetrieverDialog(dialog.Dialog):
                 target_state=True,
                 state_property="boot-completed",
                 timeout=60,
+                notifier=self.waydroid.state_notifier,
             )
 
             logger.debug("Waydroid booted")
@@ -275,45 +282,25 @@ class GSFIDRetrieverDialog(dialog.Dialog):
             if not success:
                 raise Exception(_("Timeout waiting for Waydroid to boot"))
 
-            # 尝试获取 GSF ID，最多重试30秒
-            start_time = asyncio.get_event_loop().time()
-            timeout = 30.0
-            
-            while True:
-                cli_path = os.environ.get("WAYDROID_CLI_PATH")
-                result = await self._subprocess_manager.run(
-                    command=f"pkexec {cli_path} get_android_id",
-                    shell=False
-                )
-                logger.info(result["stdout"])
+            # waydroid-cli 在容器内阻塞等待 android_id 写入，只需一次提权调用
+            result = await PrivilegedHelper().run(
+                "get_android_id", int(self.ANDROID_ID_TIMEOUT)
+            )
+            logger.info(result["stdout"])
+            if result["stderr"]:
                 logger.warning(result["stderr"])
-                
-                # 检查 stdout 是否包含 android_id| 格式的字符串
-                stdout = result["stdout"]
-                if "android_id|" in stdout:
-                    # 提取 android_id 后面的值
-                    lines = stdout.strip().split('\n')
-                    for line in lines:
-                        if line.startswith("android_id|"):
-                            self.gsf_id = line.split("|", 1)[1]
-                            logger.info(f"Successfully retrieved GSF ID: {self.gsf_id}")
-                            break
-                    else:
-                        # 如果没找到，继续重试
-                        continue
-                    
-                    # 成功获取到 GSF ID
-                    self.id_display.set_text(self.gsf_id)
-                    self.stack.set_visible_child_name("complete")
-                    return
-                
-                # 检查是否超时
-                elapsed_time = asyncio.get_event_loop().time() - start_time
-                if elapsed_time >= timeout:
-                    raise Exception(_("Timeout: Failed to retrieve GSF ID after 30 seconds"))
-                
-                # 等待1秒后重试
-                await asyncio.sleep(1.0)
+
+            for line in result["stdout"].strip().split("\n"):
+                if line.startswith("android_id|"):
+                    self.gsf_id = line.split("|", 1)[1]
+                    break
+
+            if not self.gsf_id:
+                raise Exception(_("Timeout: Failed to retrieve GSF ID after {0} seconds").format(self.ANDROID_ID_TIMEOUT))
+
+            logger.info(f"Successfully retrieved GSF ID: {self.gsf_id}")
+            self.id_display.set_text(self.gsf_id)
+            self.stack.set_visible_child_name("complete")
 
         except asyncio.CancelledError:
             return
@@ -17,12 +17,12 @@ from waydroid_helper.util.state_waiter import wait_for_state
 gi.require_version("Gtk", "4.0")
 gi.require_version("Adw", "1")
 
-from gi.repository import Adw, GObject, Gtk
+from gi.repository import Adw, GLib, GObject, Gtk
 
-from waydroid_helper.controller.app.window import create_keymapper
 from waydroid_helper.infobar import InfoBar
 from waydroid_helper.shared_folder import SharedFoldersWidget
 from waydroid_helper.util import Task, logger
+from waydroid_helper.util.startup_profiler import profiler
 from waydroid_helper.util.subprocess_manager import SubprocessManager
 from waydroid_helper.waydroid import Waydroid, WaydroidState
 from waydroid_helper.compat_widget import (
@@ -32,9 +32,6 @@ from waydroid_helper.compat_widget import (
     ADW_VERSION,
 )
 from waydroid_helper.compat_widget.message_dialog import MessageDialog
-from waydroid_helper.props_page import PropsPage
-from waydroid_helper.extensions_page import ExtensionsPage
-from waydroid_helper.scripts_page import ScriptsPage
 import os
 from waydroid_helper.config.models import RootConfig
 
@@ -42,6 +39,9 @@ from waydroid_helper.config.models import RootConfig
 class InstanceDetailPage(NavigationPage):
     __gtype_name__: str = "InstanceDetailPage"
 
+    # Tabs whose real page is built on first visit or during idle preload
+    DEFERRED_PAGES: tuple[str, ...] = ("settings", "extensions", "scripts")
+
     def __init__(
         self, waydroid: Waydroid, navigation_view, config: RootConfig, **kwargs
     ):
@@ -58,6 +58,7 @@ class InstanceDetailPage(NavigationPage):
         self._extensions_page = None
         self._scripts_page = None
         self._pages_created = False
+        self._preload_source_id: int | None = None
 
         # Create main content first - this is lightweight
         self._create_simple_content()
@@ -69,30 +70,53 @@ class InstanceDetailPage(NavigationPage):
 
     def _ensure_pages_created(self):
         """延迟创建页面实例，只在需要时创建"""
-        if not self._pages_created:
-            # 开始异步创建页面
-            self._create_pages_async()
+        if not self._pages_created and self._preload_source_id is None:
+            # 每个空闲回调只创建一个页面，避免长时间阻塞主循环
+            self._preload_source_id = GLib.idle_add(self._create_next_page)
 
-    def _create_pages_async(self):
-        from gi.repository import GLib
+    def _create_next_page(self):
+        for name in self.DEFERRED_PAGES:
+            if self._get_real_page(name) is None:
+                self._create_page(name)
+                return True
 
-        def create_pages():
-            self._props_page = PropsPage(self.waydroid)
-            self._extensions_page = ExtensionsPage(
-                self.waydroid, navigation_view=self._navigation_view
-            )
-            self._scripts_page = ScriptsPage()
-            self._pages_created = True
+        self._preload_source_id = None
+        return False
+
+    def _get_real_page(self, name: str):
+        if name == "settings":
+            return self._props_page
+        if name == "extensions":
+            return self._extensions_page
+        return self._scripts_page
+
+    def _create_page(self, name: str):
+        """创建单个真实页面并替换其占位符，模块在此时才导入"""
+        with profiler.phase(f"page_{name}"):
+            if name == "settings":
+                from waydroid_helper.props_page import PropsPage
+
+                page = PropsPage(self.waydroid)
+                self._props_page = page
+            elif name == "extensions":
+                from waydroid_helper.extensions_page import ExtensionsPage
+
+                page = ExtensionsPage(self.waydroid, navigation_view=self._navigation_view)
+                self._extensions_page = page
+            else:
+                from waydroid_helper.scripts_page import ScriptsPage
 
-            self._replace_placeholder_with_real_pages()
-            return False
+                page = ScriptsPage()
+                self._scripts_page = page
 
-        GLib.idle_add(create_pages)
+            self._pages_created = all(
+                self._get_real_page(page_name) is not None
+                for page_name in self.DEFERRED_PAGES
+            )
+            self._replace_placeholder(name, page)
 
     def _on_page_added_to_window(self, widget, param):
         if self.get_root() and not self._pages_created:
-            from gi.repository import GLib
-
             GLib.timeout_add(200, self._start_preload)
 
     def _start_preload(self):
@@ -100,6 +124,14 @@ class InstanceDetailPage(NavigationPage):
             self._ensure_pages_created()
         return False
 
+    def _get_page_info(self, name: str) -> tuple[str, str]:
+        """返回页面的标题和图标"""
+        if name == "settings":
+            return _("Settings"), "system-symbolic"
+        if name == "extensions":
+            return _("Extensions"), "addon-symbolic"
+        return _("Scripts"), "utilities-terminal-symbolic"
+
     def _add_placeholder_pages(self):
         from waydroid_helper.compat_widget import Spinner
 
@@ -153,36 +185,20 @@ class InstanceDetailPage(NavigationPage):
         )
         scripts_page.set_icon_name("utilities-terminal-symbolic")
 
-    def _replace_placeholder_with_real_pages(self):
+    def _replace_placeholder(self, name: str, page: Gtk.Widget):
         """将占位符替换为真实页面"""
-        if self._props_page and self._extensions_page and self._scripts_page:
-            # 移除旧的占位符页面
-            old_settings = self.view_stack.get_child_by_name("settings")
-            old_extensions = self.view_stack.get_child_by_name("extensions")
-            old_scripts = self.view_stack.get_child_by_name("scripts")
-
-            if old_settings:
-                self.view_stack.remove(old_settings)
-            if old_extensions:
-                self.view_stack.remove(old_extensions)
-            if old_scripts:
-                self.view_stack.remove(old_scripts)
-
-            # 添加真实页面
-            settings_page = self.view_stack.add_titled(
-                self._props_page, "settings", _("Settings")
-            )
-            settings_page.set_icon_name("system-symbolic")
+        title, icon_name = self._get_page_info(name)
+        was_visible = self.view_stack.get_visible_child_name() == name
 
-            extensions_page = self.view_stack.add_titled(
-                self._extensions_page, "extensions", _("Extensions")
-            )
-            extensions_page.set_icon_name("addon-symbolic")
+        placeholder = self.view_stack.get_child_by_name(name)
+        if placeholder:
+            self.view_stack.remove(placeholder)
 
-            scripts_page = self.view_stack.add_titled(
-                self._scripts_page, "scripts", _("Scripts")
-            )
-            scripts_page.set_icon_name("utilities-terminal-symbolic")
+        view_page = self.view_stack.add_titled(page, name, title)
+        view_page.set_icon_name(icon_name)
+
+        if was_visible:
+            self.view_stack.set_visible_child_name(name)
 
     def _create_simple_content(self):
         toolbar_view = ToolbarView.new()
@@ -298,8 +314,13 @@ class InstanceDetailPage(NavigationPage):
         current_page = stack.get_visible_child()
 
         current_page_name = stack.get_visible_child_name()
-        if current_page_name in ["settings", "extensions", "scripts"] and not self._pages_created:
-            self._ensure_pages_created()
+        if (
+            current_page_name in self.DEFERRED_PAGES
+            and self._get_real_page(current_page_name) is None
+        ):
+            # 用户正在查看该页面，立即创建
+            self._create_page(current_page_name)
+            return
 
         if hasattr(self, "refresh_button"):
             if current_page == self._extensions_page:
@@ -311,8 +332,8 @@ class InstanceDetailPage(NavigationPage):
         asyncio.create_task(self._refresh_extensions_page(button))
 
     async def _refresh_extensions_page(self, button):
-        if not self._pages_created:
-            self._ensure_pages_created()
+        if self._extensions_page is None:
+            self._create_page("extensions")
 
         stack = button.get_child()
         if isinstance(stack, Gtk.Stack):
@@ -585,6 +606,8 @@ class InstanceDetailPage(NavigationPage):
                     display_name = self.config.cage.socket_name
                 else:
                     display_name = host_display_name
+                from waydroid_helper.controller.app.window import create_keymapper
+
                 self.keymapper_proc = multiprocessing.get_context('spawn').Process(
                     target=create_keymapper,
                     args=(display_name, host_display_name),
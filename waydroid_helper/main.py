@@ -79,11 +79,16 @@ class WaydroidHelperApplication(Adw.Application):
         else:
             win = self.props.active_window
             if not win: 
-                from waydroid_helper.util.log import logger
-                from .window import WaydroidHelperWindow
+                from waydroid_helper.util.startup_profiler import profiler
+
+                with profiler.phase("import_window"):
+                    from waydroid_helper.util.log import logger
+                    from .window import WaydroidHelperWindow
 
                 self.logger = logger
-                win = WaydroidHelperWindow(application=self)
+                with profiler.phase("create_window"):
+                    win = WaydroidHelperWindow(application=self)
+                profiler.watch_first_frame(win)
             win.present()
 
     def on_about_action(self, widget: Gtk.Widget, _: GObject.Object):
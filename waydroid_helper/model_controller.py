@@ -14,6 +14,9 @@ from typing import Any
 from gi.repository import GLib, GObject
 
 from waydroid_helper.util import Task, logger
+from waydroid_helper.util.idle import IdleMonitor, counted
+from waydroid_helper.util.task import TaskSupervisor
+from waydroid_helper.util.startup_loader import StartupLoader
 from waydroid_helper.models import (
     PropertyCategory,
     PropertyModel,
@@ -24,6 +27,48 @@ from waydroid_helper.models import (
 from waydroid_helper.sdk import WaydroidSDK, PropertyManager, ConfigManager
 
 
+class SessionStateWatcher:
+    """
+    Immediate-notification source for StateWaiter.
+
+    While at least one waiter holds it, session state and boot-completed are
+    re-read every FAST_INTERVAL seconds instead of on the 2 s background poll,
+    so waiters wake up within one fast tick of the real transition.
+    """
+
+    FAST_INTERVAL = 0.25
+
+    def __init__(self, controller: "ModelController"):
+        self._controller = controller
+        self._holders = 0
+        self._task: asyncio.Task[None] | None = None
+
+    def acquire(self) -> None:
+        self._holders += 1
+        # 有等待者时保持活跃，后台轮询不能停
+        IdleMonitor().hold()
+        if self._task is None:
+            self._task = self._controller._task.create_task(self._watch())
+
+    def release(self) -> None:
+        if self._holders == 0:
+            return
+        self._holders -= 1
+        IdleMonitor().release()
+
+    async def _watch(self):
+        # 不能 cancel：一次刷新可能正在加载属性，中途取消会让属性停在 LOADING
+        # 最后一个等待者释放后，循环在当前刷新完成时自己退出
+        try:
+            while self._holders > 0:
+                await self._controller._update_session_status()
+                if self._holders == 0:
+                    break
+                await asyncio.sleep(self.FAST_INTERVAL)
+        finally:
+            self._task = None
+
+
 class ModelController(GObject.Object):
     """
     Controller that coordinates between models and SDK.
@@ -35,6 +80,10 @@ class ModelController(GObject.Object):
     - Handles async operations and error handling
     """
 
+    # 状态轮询间隔（秒），空闲模式下用 IDLE_STATUS_INTERVAL
+    STATUS_INTERVAL = 2
+    IDLE_STATUS_INTERVAL = 30
+
     def __init__(self):
         super().__init__()
 
@@ -49,8 +98,14 @@ class ModelController(GObject.Object):
 
         # Task management
         self._task = Task()
+        self._tasks = TaskSupervisor().scope("ModelController", owner=self)
         self._status_update_lock = asyncio.Lock()
         self._monitoring_started = False
+        self._status_source_id: int | None = None
+        self._recovery_source_id: int | None = None
+        self.state_notifier = SessionStateWatcher(self)
+        # Per-phase durations (ms) of the last property load
+        self.load_timings: dict[str, float] = {}
 
         # Defer async initialization until event loop is available
         GLib.idle_add(self._start_status_monitoring)
@@ -65,14 +120,53 @@ class ModelController(GObject.Object):
         # Initial status check
         self._task.create_task(self._initial_status_check())
 
-        # Schedule periodic updates every 2 seconds
-        GLib.timeout_add_seconds(2, self._schedule_status_update)
+        self._add_poll_timers()
 
-        # Schedule periodic ERROR state recovery checks every 10 seconds
-        GLib.timeout_add_seconds(10, self._schedule_error_recovery)
+        # 空闲模式下改为慢速轮询，恢复活跃时立即刷新一次
+        IdleMonitor().register(on_idle=self._slow_down_polling, on_active=self._resume_polling)
+        IdleMonitor().start()
 
         return False  # Don't repeat this idle callback
 
+    def _add_poll_timers(self, idle: bool = False):
+        # Schedule periodic updates every STATUS_INTERVAL seconds (IDLE_STATUS_INTERVAL when idle)
+        status_interval = self.IDLE_STATUS_INTERVAL if idle else self.STATUS_INTERVAL
+        if self._status_source_id is None:
+            self._status_source_id = GLib.timeout_add_seconds(
+                status_interval, counted("ModelController.status", self._schedule_status_update)
+            )
+
+        # Schedule periodic ERROR state recovery checks every 10 seconds
+        if self._recovery_source_id is None and not idle:
+            self._recovery_source_id = GLib.timeout_add_seconds(
+                10, counted("ModelController.recovery", self._schedule_error_recovery)
+            )
+
+    def _remove_poll_timers(self):
+        for source_id in (self._status_source_id, self._recovery_source_id):
+            if source_id is not None:
+                GLib.source_remove(source_id)
+        self._status_source_id = None
+        self._recovery_source_id = None
+
+    def _slow_down_polling(self):
+        """
+        空闲时只保留慢速的状态轮询
+
+        The main window losing focus is not the app going away: a session
+        started or stopped from a terminal must still show up, just later.
+        Error recovery waits for the next activity.
+        """
+        self._remove_poll_timers()
+        self._add_poll_timers(idle=True)
+
+    def _resume_polling(self):
+        if not self._monitoring_started:
+            return
+        self._remove_poll_timers()
+        self._schedule_status_update()
+        self._add_poll_timers()
+
     async def _initial_status_check(self):
         """Initial status check with forced property loading"""
         try:
@@ -83,27 +177,45 @@ class ModelController(GObject.Object):
 
             # Force load privileged and waydroid properties if waydroid is initialized
             if current_state in (SessionState.STOPPED, SessionState.RUNNING):
-                await self._load_privileged_properties()
-                await self._load_waydroid_properties()
-                await self._load_android_version()
-
-            # Load persist properties if session is running
-            if current_state == SessionState.RUNNING:
-                await self._load_persist_properties()
+                await self._load_all_properties(
+                    include_persist=current_state == SessionState.RUNNING
+                )
 
         except Exception as e:
             logger.error(f"Failed initial status check: {e}")
 
+    async def _load_all_properties(self, include_persist: bool):
+        """
+        Load every property category, each published as soon as it is done.
+
+        The privileged and waydroid categories are read synchronously from
+        the local waydroid.cfg and do not overlap with anything; the persist
+        properties and the Android version wait on subprocesses, and those
+        waits overlap. The Android version reads images_path from the config
+        loaded by the waydroid phase, so it is skipped when that phase fails.
+        """
+        loader = StartupLoader("property-load")
+        _ = loader.add_phase("privileged", self._load_privileged_properties)
+        _ = loader.add_phase("waydroid", self._load_waydroid_properties)
+        _ = loader.add_phase(
+            "android_version", self._load_android_version, depends_on=("waydroid",)
+        )
+        if include_persist:
+            _ = loader.add_phase("persist", self._load_persist_properties)
+
+        self.load_timings = await loader.run()
+
     def _schedule_status_update(self) -> bool:
         """Schedule a status update task"""
-        # self._task.create_task(self._update_session_status())
-        asyncio.create_task(self._update_session_status())
+        # 上一次更新还没结束时跳过，避免任务堆积
+        if not self._tasks.is_running("status-update"):
+            self._tasks.create_task(self._update_session_status(), name="status-update")
         return True  # Continue the timeout
 
     def _schedule_error_recovery(self) -> bool:
         """Schedule an error recovery check"""
-        # self._task.create_task(self._handle_error_state_recovery())
-        asyncio.create_task(self._handle_error_state_recovery())
+        if not self._tasks.is_running("error-recovery"):
+            self._tasks.create_task(self._handle_error_state_recovery(), name="error-recovery")
         return True  # Continue the timeout
 
     async def _update_session_status(self):
@@ -137,12 +249,11 @@ class ModelController(GObject.Object):
 
         # When session becomes running, load persist properties
         if new_state == SessionState.RUNNING and old_state != SessionState.RUNNING:
-            await self._load_persist_properties()
-            # Also load Android version if coming from UNINITIALIZED
+            # Also load config properties if coming from UNINITIALIZED
             if old_state == SessionState.UNINITIALIZED:
-                await self._load_android_version()
-                await self._load_privileged_properties()
-                await self._load_waydroid_properties()
+                await self._load_all_properties(include_persist=True)
+            else:
+                await self._load_persist_properties()
 
         # When session stops, reset persist props state but keep privileged props
         elif new_state == SessionState.STOPPED and old_state == SessionState.RUNNING:
@@ -155,8 +266,9 @@ class ModelController(GObject.Object):
             and old_state == SessionState.UNINITIALIZED
         ):
             await self._load_privileged_properties_with_retry()
-            await self._load_waydroid_properties_with_retry()
-            await self._load_android_version()
+            # Android 版本要读 waydroid 配置里的 images_path
+            if await self._load_waydroid_properties_with_retry():
+                await self._load_android_version()
 
         # When waydroid becomes completely uninitialized, reset all states
         elif new_state == SessionState.UNINITIALIZED:
@@ -208,7 +320,8 @@ class ModelController(GObject.Object):
         except Exception as e:
             logger.error(f"Failed to load privileged properties: {e}")
             self.property_model.set_property("privileged-state", ModelState.ERROR)
-            # Don't raise - allow other operations to continue
+            # 调用方据此重试或跳过依赖它的加载
+            raise
 
     async def _load_waydroid_properties(self):
         """Load waydroid config properties from [waydroid] section"""
@@ -230,14 +343,15 @@ class ModelController(GObject.Object):
         except Exception as e:
             logger.error(f"Failed to load waydroid properties: {e}")
             self.property_model.set_property("waydroid-state", ModelState.ERROR)
-            # Don't raise - allow other operations to continue
+            # 调用方据此重试或跳过依赖它的加载
+            raise
 
-    async def _load_privileged_properties_with_retry(self, max_retries: int = 3):
-        """Load privileged properties with retry mechanism"""
+    async def _load_privileged_properties_with_retry(self, max_retries: int = 3) -> bool:
+        """Load privileged properties with retry mechanism, returns whether it succeeded"""
         for attempt in range(max_retries):
             try:
                 await self._load_privileged_properties()
-                return  # Success, exit retry loop
+                return True
             except Exception as e:
                 logger.warning(
                     f"Attempt {attempt + 1}/{max_retries} to load privileged properties failed: {e}"
@@ -249,13 +363,14 @@ class ModelController(GObject.Object):
                     logger.error(
                         f"Failed to load privileged properties after {max_retries} attempts"
                     )
+        return False
 
-    async def _load_waydroid_properties_with_retry(self, max_retries: int = 3):
-        """Load waydroid properties with retry mechanism"""
+    async def _load_waydroid_properties_with_retry(self, max_retries: int = 3) -> bool:
+        """Load waydroid properties with retry mechanism, returns whether it succeeded"""
         for attempt in range(max_retries):
             try:
                 await self._load_waydroid_properties()
-                return  # Success, exit retry loop
+                return True
             except Exception as e:
                 logger.warning(
                     f"Attempt {attempt + 1}/{max_retries} to load waydroid properties failed: {e}"
@@ -267,6 +382,7 @@ class ModelController(GObject.Object):
                     logger.error(
                         f"Failed to load waydroid properties after {max_retries} attempts"
                     )
+        return False
 
     async def _handle_error_state_recovery(self):
         """Handle recovery from ERROR states by retrying failed operations"""
@@ -321,8 +437,13 @@ class ModelController(GObject.Object):
             logger.error(f"Failed to refresh persist property {property_name}: {e}")
             return False
 
-    async def save_all_privileged_properties(self) -> bool:
-        """Save all privileged properties to config file"""
+    async def save_all_privileged_properties(self, upgrade: bool = False) -> bool:
+        """
+        Save all privileged properties to config file.
+
+        Only a config that differs from the loaded snapshot is written, and
+        the offline upgrade is skipped as well when nothing changed.
+        """
         try:
             # Prepare all privileged properties for saving
             privileged_props = self.property_model.get_privileged_properties()
@@ -336,9 +457,16 @@ class ModelController(GObject.Object):
             # Set all properties in config
             self.config_manager.set_multiple_privileged_properties(properties_to_save)
 
+            if not self.config_manager.has_pending_changes():
+                logger.info("Privileged properties unchanged, nothing to save")
+                return True
+
             # Save config file
             success = await self.config_manager.save_config()
 
+            if success and upgrade:
+                return await self.upgrade(offline=True)
+
             return success
 
         except Exception as e:
@@ -385,6 +513,10 @@ class ModelController(GObject.Object):
             for prop in props:
                 self.config_manager.set_privileged_property(prop.get_nick(), "")
 
+            if not self.config_manager.has_pending_changes():
+                self.property_model.set_property("privileged-state", ModelState.READY)
+                return True
+
             success = await self.config_manager.save_config()
             if success:
                 return await self.upgrade(offline=True)
@@ -397,8 +529,13 @@ class ModelController(GObject.Object):
             self.property_model.set_property("privileged-state", ModelState.ERROR)
             return False
 
-    async def save_all_waydroid_properties(self) -> bool:
-        """Save all waydroid config properties to [waydroid] section"""
+    async def save_all_waydroid_properties(self, upgrade: bool = False) -> bool:
+        """
+        Save all waydroid config properties to [waydroid] section.
+
+        The container restart and the optional offline upgrade only run when
+        the config actually changed.
+        """
         try:
             # Prepare all waydroid properties for saving
             waydroid_props = self.property_model.get_waydroid_properties()
@@ -412,6 +549,10 @@ class ModelController(GObject.Object):
             # Set all properties in config
             self.config_manager.set_multiple_waydroid_properties(properties_to_save)
 
+            if not self.config_manager.has_pending_changes():
+                logger.info("Waydroid properties unchanged, nothing to save")
+                return True
+
             # Save config file
             success = await self.config_manager.save_config()
 
@@ -420,6 +561,10 @@ class ModelController(GObject.Object):
                 await self.waydroid_sdk.stop_session(wait=True)
                 await self.waydroid_sdk.restart_container(wait=True)
 
+                if upgrade:
+                    logger.debug("Upgrade waydroid config properties")
+                    return await self.upgrade(offline=True)
+
             return success
 
         except Exception as e:
@@ -438,6 +583,10 @@ class ModelController(GObject.Object):
                 raw_value = self.property_model.get_property_raw_value(prop.get_name())
                 self.config_manager.set_waydroid_property(nick, raw_value)
 
+            if not self.config_manager.has_pending_changes():
+                self.property_model.set_property("waydroid-state", ModelState.READY)
+                return True
+
             success = await self.config_manager.save_config()
             if success:
                 return await self.upgrade(offline=True)
@@ -17,7 +17,8 @@ from typing import Any, Dict, List, Optional, Tuple
 from gi.repository import GLib
 from gi.repository.GObject import ParamSpec
 
-from waydroid_helper.util import SubprocessError, SubprocessManager, logger
+from waydroid_helper.util import SubprocessError, SubprocessManager, Task, logger
+from waydroid_helper.util.privileged import PrivilegedHelper
 from waydroid_helper.models import SessionState
 
 class WaydroidSDK:
@@ -91,9 +92,13 @@ class WaydroidSDK:
             return False
     
     async def restart_container(self, wait: bool = False) -> bool:
-        """"""
+        """Restart the Waydroid container; with wait=False return once the restart is started"""
+        if not wait:
+            # 两种方式都走 PrivilegedHelper，不等待时在后台完成并记录失败
+            Task().create_task(self.restart_container(wait=True))
+            return True
         try:
-            await self._subprocess.run(f"pkexec {os.environ['WAYDROID_CLI_PATH']} restart_container", flag=True, wait=wait, shell=False)
+            await PrivilegedHelper().run("restart_container")
             return True
         except SubprocessError as e:
             logger.error(f"Failed to restart Waydroid container: {e}")
@@ -179,18 +184,38 @@ class ConfigManager:
     - Returns results without managing state
     """
     
+    # Edits arriving within this window are committed by a single privileged write
+    SAVE_DEBOUNCE_DELAY = 0.3
+
     def __init__(self):
         self._subprocess: SubprocessManager = SubprocessManager()
         self._config_cache: configparser.ConfigParser | None = None
+        # Section -> option -> value, as last read from or written to disk
+        self._snapshot: dict[str, dict[str, str]] = {}
+        self._pending_save: asyncio.Future[bool] | None = None
+        self._save_lock: asyncio.Lock = asyncio.Lock()
     
     def load_config(self, config_path: str = "/var/lib/waydroid/waydroid.cfg") -> bool:
-        """Load Waydroid configuration file with improved error handling"""
+        """
+        Load Waydroid configuration file with improved error handling.
+
+        While a debounced save is pending or being written, the edits it
+        carries are re-applied on top of the reloaded file instead of being
+        dropped.
+        """
+        unsaved: dict[str, dict[str, str | None]] = {}
+        if self._config_cache and (self._pending_save is not None or self._save_lock.locked()):
+            unsaved = self.get_pending_changes()
+
         try:
             # Check if config file exists
             if not os.path.exists(config_path):
                 logger.warning(f"Config file does not exist: {config_path}")
                 # Try to create a minimal config
-                return self._create_minimal_config()
+                if not self._create_minimal_config():
+                    return False
+                self._apply_changes(unsaved)
+                return True
 
             # Check if config file is readable
             if not os.access(config_path, os.R_OK):
@@ -209,6 +234,8 @@ class ConfigManager:
                 logger.warning("Config missing [waydroid] section, adding it")
                 self._config_cache.add_section("waydroid")
 
+            self._snapshot = self._dump_config()
+            self._apply_changes(unsaved)
             return True
         except Exception as e:
             logger.error(f"Failed to load config: {e}")
@@ -224,6 +251,8 @@ class ConfigManager:
             self._config_cache.add_section("waydroid")
             # Add some default waydroid settings
             self._config_cache.set("waydroid", "images_path", "/var/lib/waydroid/images")
+            # Nothing is on disk yet, so everything counts as a change
+            self._snapshot = {}
             return True
         except Exception as e:
             logger.error(f"Failed to create minimal config: {e}")
@@ -346,12 +375,94 @@ class ConfigManager:
     #     for p in param_specs:
     #         self._config_cache.set("waydroid", p.get_nick(), p.get_default_value())
 
+    def _dump_config(self) -> dict[str, dict[str, str]]:
+        """Flatten the cached config into plain dicts for comparison"""
+        if not self._config_cache:
+            return {}
+
+        return {
+            section: {
+                option: self._config_cache.get(section, option, raw=True)
+                for option in self._config_cache.options(section)
+            }
+            for section in self._config_cache.sections()
+        }
+
+    def _apply_changes(self, changes: dict[str, dict[str, str | None]]) -> None:
+        """Apply a change set from get_pending_changes() to the cached config"""
+        if not self._config_cache:
+            return
+
+        for section, options in changes.items():
+            if not self._config_cache.has_section(section):
+                self._config_cache.add_section(section)
+            for option, value in options.items():
+                if value is None:
+                    self._config_cache.remove_option(section, option)
+                else:
+                    self._config_cache.set(section, option, value)
+
+    def get_pending_changes(self) -> dict[str, dict[str, str | None]]:
+        """
+        Get the change set between the cached config and the loaded snapshot.
+
+        Returns section -> option -> new value, where None marks a removed option.
+        """
+        current = self._dump_config()
+        changes: dict[str, dict[str, str | None]] = {}
+
+        for section in current.keys() | self._snapshot.keys():
+            new_options = current.get(section, {})
+            old_options = self._snapshot.get(section, {})
+            section_changes: dict[str, str | None] = {}
+            for option in new_options.keys() | old_options.keys():
+                new_value = new_options.get(option)
+                if new_value != old_options.get(option):
+                    section_changes[option] = new_value
+            if section_changes:
+                changes[section] = section_changes
+
+        return changes
+
+    def has_pending_changes(self) -> bool:
+        """Check whether the cached config differs from what is on disk"""
+        return bool(self.get_pending_changes())
+
     async def save_config(self) -> bool:
-        """Save config to file using privileged access"""
+        """
+        Save config to file using privileged access.
+
+        Calls made within SAVE_DEBOUNCE_DELAY share one write, and the write is
+        skipped entirely when nothing differs from the loaded snapshot.
+        """
         if not self._config_cache:
             logger.error("No config loaded to save")
             return False
-        
+
+        if self._pending_save is None:
+            self._pending_save = asyncio.ensure_future(self._debounced_save())
+        return await asyncio.shield(self._pending_save)
+
+    async def _debounced_save(self) -> bool:
+        await asyncio.sleep(self.SAVE_DEBOUNCE_DELAY)
+        # Later edits must schedule a fresh write
+        self._pending_save = None
+        async with self._save_lock:
+            return await self._write_config()
+
+    async def _write_config(self) -> bool:
+        if not self._config_cache:
+            logger.error("No config loaded to save")
+            return False
+
+        changes = self.get_pending_changes()
+        if not changes:
+            logger.debug("Config unchanged, skipping privileged write")
+            return True
+
+        logger.debug(f"Committing config changes: {changes}")
+        written = self._dump_config()
+
         try:
             # Save to cache directory first
             cache_dir = os.path.join(GLib.get_user_cache_dir(), "waydroid-helper")
@@ -361,9 +472,9 @@ class ConfigManager:
             with open(cache_config_path, "w") as f:
                 self._config_cache.write(f)
             
-            # Copy to system location with pkexec
-            cmd = f"pkexec {os.environ['WAYDROID_CLI_PATH']} copy_to_var {cache_config_path} waydroid.cfg"
-            await self._subprocess.run(cmd, flag=True, shell=False)
+            # Copy to system location through the privileged helper
+            await PrivilegedHelper().run("copy_to_var", cache_config_path, "waydroid.cfg")
+            self._snapshot = written
             return True
         except SubprocessError as e:
             logger.error(f"Failed to save config: {e}")
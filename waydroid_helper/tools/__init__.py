@@ -1,4 +1,5 @@
 from .extensions_manager import ExtensionManagerState, PackageManager
+from .helper_service import start as start_helper
 from .monitor_service import start as start_monitor
 from .mount_service import start as start_mount
 
@@ -6,5 +7,6 @@ __all__ = [
     'PackageManager',
     'ExtensionManagerState',
     "start_monitor",
-    "start_mount"
+    "start_mount",
+    "start_helper",
 ]
\ No newline at end of file
@@ -7,6 +7,7 @@ import asyncio
 import json
 import os
 import re
+import time
 import xml.etree.ElementTree as ET
 from collections.abc import Coroutine, Iterable
 from enum import IntEnum
@@ -19,11 +20,19 @@ import httpx
 import yaml
 from gi.repository import GLib, GObject
 
+from waydroid_helper.tools.privileged_batch import (
+    BATCH_ACTIONS,
+    BatchResult,
+    BatchStep,
+    parse_results,
+    write_batch,
+)
 from waydroid_helper.util.state_waiter import wait_for_state
 from waydroid_helper.util.abx_reader import AbxReader
 from waydroid_helper.util.arch import host
 from waydroid_helper.util.log import logger
-from waydroid_helper.util.subprocess_manager import SubprocessManager
+from waydroid_helper.util.privileged import PrivilegedHelper
+from waydroid_helper.util.subprocess_manager import SubprocessError, SubprocessManager
 from waydroid_helper.util.task import Task
 from waydroid_helper.waydroid import Waydroid, WaydroidState
 
@@ -586,10 +595,7 @@ class PackageManager(GObject.Object):
                 logger.info(f"Pre-install operations completed: {package_name}")
             
             logger.info(f"Starting package installation to system: {package_name}")
-            await self._subprocess.run(
-                f'pkexec {os.environ["WAYDROID_CLI_PATH"]} install "{package}"',
-                shell=False,
-            )
+            await PrivilegedHelper().run("install", package)
             logger.info(f"Package installation to system completed: {package_name}")
 
             installed_files = self.get_all_files_relative(pkgdir)
@@ -669,41 +675,70 @@ class PackageManager(GObject.Object):
         if operation_key not in yml:
             return
 
-        # commands = []
+        # 所有操作编译成一个批处理，只提权一次
+        pkgdir = os.path.join(self.cache_dir, "extensions", info["name"], "pkg")
+        steps: list[BatchStep] = []
         operations = yml[operation_key]
         for operation in operations:
             for func_name, args in operation.items():
-                commands = await self.generate_command(func_name, args)
-                if commands:
-                    for cmd in commands:
-
-                        cmd = bash_var_replacement_regex(
-                            cmd,
-                            {
-                                "pkgdir": os.path.join(
-                                    self.cache_dir, "extensions", info["name"], "pkg"
-                                )
-                            },
-                        )
-                        resp = await self._subprocess.run(cmd, shell=False)
-                        logger.info(resp)
+                generated = await self.generate_steps(func_name, args)
+                if generated:
+                    for step in generated:
+                        step.args = [
+                            bash_var_replacement_regex(arg, {"pkgdir": pkgdir})
+                            for arg in step.args
+                        ]
+                    steps.extend(generated)
                 else:
                     logger.error(
                         f"Unsupported function or invalid arguments: {func_name}"
                     )
 
-        # commands_str = ";".join(commands)
-        # print(f'pkexec bash -c "{commands_str}"')
-        # await self._subprocess.run(
-        #     f'pkexec bash -c "{commands_str}"',
-        #     env={
-        #         "pkgdir": os.path.join(
-        #             self.cache_dir, "extensions", info["name"], "pkg"
-        #         )
-        #     },
-        # )
+        if not steps:
+            return
+        result = await self.run_batch(steps)
+        if result is None:
+            # 不能当作成功：安装流程会继续并把包记录为已安装
+            raise ValueError(f"Invalid {operation_key} operations: {info['name']}")
+        for step in result.steps:
+            logger.info(
+                f"{operation_key} step {step.index} {step.action}: {step.status} "
+                f"(returncode {step.returncode}, {step.elapsed_ms}ms)"
+            )
+        if result.stderr:
+            logger.info(result.stderr)
+        logger.info(
+            f"{operation_key} of {info['name']}: {len(steps)} steps in one batch, "
+            f"{result.elapsed_ms:.0f}ms"
+        )
+        if not result.ok:
+            raise SubprocessError(result.returncode, result.stderr.encode())
+
+    async def run_batch(self, steps: list[BatchStep]) -> BatchResult | None:
+        """通过一次 pkexec 执行所有步骤，步骤不合法时返回 None"""
+        batch = write_batch(steps, os.path.join(self.cache_dir, "batch"))
+        if batch is None:
+            return None
+        path, digest = batch
+        start = time.monotonic()
+        try:
+            resp = await self._subprocess.run(
+                f'pkexec {os.environ["WAYDROID_CLI_PATH"]} run_batch "{path}" {digest}',
+                shell=False,
+            )
+            returncode, stdout, stderr = resp["returncode"], resp["stdout"], resp["stderr"]
+        except SubprocessError as e:
+            returncode, stdout, stderr = e.returncode, e.stdout.decode(), e.stderr.decode()
+        finally:
+            os.remove(path)
+        return BatchResult(
+            steps=parse_results(stdout),
+            returncode=returncode,
+            stderr=stderr.strip(),
+            elapsed_ms=(time.monotonic() - start) * 1000,
+        )
 
-    async def get_apk_path(self, apks: list[str]) -> str:
+    async def get_apk_path(self, apks: list[str]) -> list[str]:
         paths: list[str] = []
         data_dir = os.path.join(GLib.get_user_data_dir(), "waydroid/data")
         package_path = os.path.join(data_dir, "system/packages.xml")
@@ -724,64 +759,38 @@ class PackageManager(GObject.Object):
                 apks.remove(name)
                 if len(apks) == 0:
                     break
-        paths = ['"' + path + '"' for path in paths]
-        return " ".join(paths)
-
-    async def generate_command(self, func_name: str, args: Any):
-        command_map = {
-            "rm_overlay_rw": "pkexec {cli_path} rm_overlay_rw {paths}",
-            "rm_data": "pkexec {cli_path} rm_data {paths}",
-            "cp_to_data": 'pkexec {cli_path} cp_to_data "{src}" "{dest}"',
-            "rm_apk": "pkexec {cli_path} rm_apk {apks}",
-        }
-
-        if func_name in command_map:
-            if func_name == "cp_to_data":
-                src = args.get("src")
-                dest = args.get("dest")
-                if src and dest:
-                    return [
-                        command_map[func_name].format(
-                            cli_path=os.environ["WAYDROID_CLI_PATH"], src=src, dest=dest
-                        )
-                    ]
-            elif func_name == "rm_apk":
-                apks = " ".join(['"' + apk + '"' for apk in args])
-
-                await self.waydroid.start_session()
-
-                success = await wait_for_state(
-                    self.waydroid._controller.property_model,
-                    target_state=True,
-                    state_property="boot-completed",
-                    timeout=30,
-                )
-
-                if not success:
-                    logger.error("Timeout waiting for waydroid to boot")
+        return paths
+
+    async def generate_steps(self, func_name: str, args: Any) -> list[BatchStep] | None:
+        if func_name not in BATCH_ACTIONS:
+            return None
+
+        if func_name == "cp_to_data":
+            src = args.get("src")
+            dest = args.get("dest")
+            if src and dest:
+                return [BatchStep(func_name, [src, dest])]
+        elif func_name == "rm_apk":
+            await self.waydroid.start_session()
+
+            success = await wait_for_state(
+                self.waydroid._controller.property_model,
+                target_state=True,
+                state_property="boot-completed",
+                timeout=30,
+            )
 
-                commands = [
-                    command_map[func_name].format(
-                        cli_path=os.environ["WAYDROID_CLI_PATH"], apks=apks
-                    )
-                ]
-                paths = await self.get_apk_path(args)
-                if paths.strip() != "":
-                    commands.insert(
-                        0,
-                        command_map["rm_data"].format(
-                            cli_path=os.environ["WAYDROID_CLI_PATH"], paths=paths
-                        ),
-                    )
-                return commands
+            if not success:
+                logger.error("Timeout waiting for waydroid to boot")
 
-            else:
-                paths = " ".join(['"' + path + '"' for path in args])
-                return [
-                    command_map[func_name].format(
-                        cli_path=os.environ["WAYDROID_CLI_PATH"], paths=paths
-                    )
-                ]
+            steps = [BatchStep(func_name, list(args))]
+            # get_apk_path 会从列表里移除找到的包名
+            paths = await self.get_apk_path(list(args))
+            if paths:
+                steps.insert(0, BatchStep("rm_data", paths))
+            return steps
+        else:
+            return [BatchStep(func_name, list(args))]
 
         return None
 
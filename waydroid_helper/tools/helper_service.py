@@ -0,0 +1,281 @@
+"""
+常驻的提权服务
+
+id.waydro.Helper implements the waydroid-cli verbs the GUI calls most
+often (copy_to_var, install, get_android_id, restart_container) in a
+root process started by DBus activation, so a repeated privileged
+operation is one IPC call instead of polkit + pkexec + bash every time.
+
+Callers are authorized through polkit (com.jaoushingan.WaydroidHelper.helper)
+on their first call. The result is kept for the caller's bus connection,
+i.e. until that GUI instance exits, so the password is asked at most once
+per session. The service exits after IDLE_EXIT seconds without calls and
+is started again by the next call.
+"""
+
+import os
+import pwd
+import shutil
+import subprocess
+import threading
+from typing import Any, Callable, final
+
+import dbus.mainloop.glib
+import dbus.service
+from gi.repository import GLib
+
+import dbus
+
+BUS_NAME = "id.waydro.Helper"
+OBJECT_PATH = "/org/waydro/Helper"
+POLKIT_ACTION = "com.jaoushingan.WaydroidHelper.helper"
+
+VAR_DIR = os.path.realpath("/var/lib/waydroid")
+OVERLAY_DIR = os.path.join(VAR_DIR, "overlay")
+
+IDLE_EXIT = 600
+
+
+@final
+class HelperError(dbus.DBusException):
+    _dbus_error_name = "id.waydro.HelperError"
+
+
+@final
+class NotAuthorizedError(dbus.DBusException):
+    _dbus_error_name = "id.waydro.Helper.NotAuthorized"
+
+
+def _result(returncode: int, stdout: str = "", stderr: str = "") -> dict[str, Any]:
+    return {"returncode": returncode, "stdout": stdout, "stderr": stderr}
+
+
+def _run(command: list[str], timeout: float | None = None) -> dict[str, Any]:
+    result = subprocess.run(command, capture_output=True, text=True, timeout=timeout)
+    return _result(result.returncode, result.stdout, result.stderr)
+
+
+def copy_to_var(source: str, dest: str) -> dict[str, Any]:
+    """与 waydroid-cli copy_to_var 相同：dest 相对 /var/lib/waydroid，以 / 结尾时表示目录"""
+    dest_path = os.path.realpath(os.path.join(VAR_DIR, dest))
+    if not dest_path.startswith(VAR_DIR + "/"):
+        return _result(1, stderr=f"Error: {dest_path} is outside of {VAR_DIR}\n")
+
+    if dest.endswith("/") and not os.path.exists(dest_path):
+        os.makedirs(dest_path, exist_ok=True)
+    else:
+        os.makedirs(os.path.dirname(dest_path), exist_ok=True)
+    if os.path.isdir(dest_path):
+        dest_path = os.path.join(dest_path, os.path.basename(os.path.normpath(source)))
+
+    if os.path.isdir(source):
+        shutil.copytree(source, dest_path, symlinks=True, dirs_exist_ok=True)
+    else:
+        shutil.copy2(source, dest_path)
+    return _result(0)
+
+
+def install(package: str) -> dict[str, Any]:
+    return _run(["tar", "-xzpf", package, "-C", OVERLAY_DIR])
+
+
+def get_android_id(timeout: int) -> dict[str, Any]:
+    """与 waydroid-cli get_android_id 相同：在容器内等待 GMS 写入 android_id"""
+    subprocess.run(
+        ["waydroid", "shell", "--", "sh", "-c", "am start -a android.settings.ADD_ACCOUNT_SETTINGS"],
+        capture_output=True,
+    )
+    script = (
+        f"i=0; while [ $i -lt {timeout * 2} ]; do "
+        "out=$(sqlite3 /data/data/*/*/gservices.db "
+        "'select * from main where name = \"android_id\";' 2>&1); "
+        'case "$out" in android_id\\|*) echo "$out"; exit 0;; esac; '
+        'i=$((i + 1)); sleep 0.5; done; echo "$out"'
+    )
+    result = subprocess.run(
+        ["waydroid", "shell", "--", "sh", "-c", script],
+        capture_output=True,
+        text=True,
+        timeout=timeout + 15,
+    )
+    output = (result.stdout + result.stderr).strip()
+    if output.startswith("android_id|") and output.split("|", 1)[1].isdigit():
+        return _result(0, stdout=output + "\n")
+    return _result(0, stderr=output + "\n")
+
+
+def restart_container() -> dict[str, Any]:
+    return _run(["waydroid", "container", "restart"])
+
+
+def ping(uid: int) -> dict[str, Any]:
+    """空操作，输出调用方的用户名"""
+    try:
+        return _result(0, stdout=pwd.getpwuid(uid).pw_name + "\n")
+    except KeyError:
+        return _result(0, stdout=f"{uid}\n")
+
+
+class HelperService(dbus.service.Object):
+    def __init__(self, loop: GLib.MainLoop):
+        self.bus = dbus.SystemBus()
+        bus_name = dbus.service.BusName(BUS_NAME, bus=self.bus)
+        dbus.service.Object.__init__(self, bus_name, OBJECT_PATH)
+        self.loop = loop
+        # 已授权的调用方连接（唯一总线名）
+        self._authorized: set[str] = set()
+        self._running: int = 0
+        self._idle_source_id: int | None = None
+        self._authority = dbus.Interface(
+            self.bus.get_object("org.freedesktop.PolicyKit1", "/org/freedesktop/PolicyKit1/Authority"),
+            "org.freedesktop.PolicyKit1.Authority",
+        )
+        self.bus.add_signal_receiver(
+            self._on_name_owner_changed,
+            signal_name="NameOwnerChanged",
+            dbus_interface="org.freedesktop.DBus",
+            bus_name="org.freedesktop.DBus",
+        )
+        self._arm_idle_exit()
+
+    def _on_name_owner_changed(self, name: str, old_owner: str, new_owner: str) -> None:
+        # 调用方断开连接后授权失效
+        if not new_owner:
+            self._authorized.discard(str(name))
+
+    def _arm_idle_exit(self) -> None:
+        if self._idle_source_id is not None:
+            GLib.source_remove(self._idle_source_id)
+        self._idle_source_id = GLib.timeout_add_seconds(IDLE_EXIT, self._on_idle_exit)
+
+    def _on_idle_exit(self) -> bool:
+        self._idle_source_id = None
+        if self._running > 0:
+            self._arm_idle_exit()
+        else:
+            self.loop.quit()
+        return False
+
+    def _authorize(
+        self,
+        sender: str,
+        on_authorized: Callable[[], None],
+        error: Callable[[Exception], None],
+    ) -> None:
+        if sender in self._authorized:
+            on_authorized()
+            return
+
+        def reply(result: Any) -> None:
+            is_authorized = bool(result[0])
+            if not is_authorized:
+                error(NotAuthorizedError(f"{sender} is not authorized for {POLKIT_ACTION}"))
+                return
+            self._authorized.add(sender)
+            on_authorized()
+
+        subject = ("system-bus-name", {"name": dbus.String(sender, variant_level=1)})
+        # flags 1: AllowUserInteraction，需要时弹出认证对话框
+        self._authority.CheckAuthorization(
+            subject,
+            POLKIT_ACTION,
+            dbus.Dictionary({}, signature="ss"),
+            dbus.UInt32(1),
+            "",
+            reply_handler=reply,
+            error_handler=lambda e: error(HelperError(f"Authorization failed: {e}")),
+            timeout=300,
+        )
+
+    def _dispatch(
+        self,
+        sender: str,
+        work: Callable[[], dict[str, Any]],
+        reply: Callable[[dict[str, Any]], None],
+        error: Callable[[Exception], None],
+    ) -> None:
+        """授权后在线程里执行，结果回到主循环再回复，慢操作不会阻塞其他调用"""
+        self._arm_idle_exit()
+
+        def finish(result: dict[str, Any] | None, exc: Exception | None) -> bool:
+            self._running -= 1
+            if exc is not None:
+                error(HelperError(f"Unexpected error: {exc}"))
+            else:
+                reply(result)
+            return False
+
+        def worker() -> None:
+            try:
+                result = work()
+            except Exception as e:
+                GLib.idle_add(finish, None, e)
+            else:
+                GLib.idle_add(finish, result, None)
+
+        def start() -> None:
+            self._running += 1
+            threading.Thread(target=worker, daemon=True).start()
+
+        self._authorize(sender, start, error)
+
+    @dbus.service.method(
+        BUS_NAME,
+        in_signature="ss",
+        out_signature="a{sv}",
+        sender_keyword="sender",
+        async_callbacks=("reply", "error"),
+    )
+    def CopyToVar(self, source, dest, sender=None, reply=None, error=None):
+        source_str, dest_str = str(source), str(dest)
+        self._dispatch(sender, lambda: copy_to_var(source_str, dest_str), reply, error)
+
+    @dbus.service.method(
+        BUS_NAME,
+        in_signature="s",
+        out_signature="a{sv}",
+        sender_keyword="sender",
+        async_callbacks=("reply", "error"),
+    )
+    def Install(self, package, sender=None, reply=None, error=None):
+        package_str = str(package)
+        self._dispatch(sender, lambda: install(package_str), reply, error)
+
+    @dbus.service.method(
+        BUS_NAME,
+        in_signature="u",
+        out_signature="a{sv}",
+        sender_keyword="sender",
+        async_callbacks=("reply", "error"),
+    )
+    def GetAndroidId(self, timeout, sender=None, reply=None, error=None):
+        timeout_i = int(timeout)
+        self._dispatch(sender, lambda: get_android_id(timeout_i), reply, error)
+
+    @dbus.service.method(
+        BUS_NAME,
+        in_signature="",
+        out_signature="a{sv}",
+        sender_keyword="sender",
+        async_callbacks=("reply", "error"),
+    )
+    def RestartContainer(self, sender=None, reply=None, error=None):
+        self._dispatch(sender, restart_container, reply, error)
+
+    @dbus.service.method(
+        BUS_NAME,
+        in_signature="",
+        out_signature="a{sv}",
+        sender_keyword="sender",
+        async_callbacks=("reply", "error"),
+    )
+    def Ping(self, sender=None, reply=None, error=None):
+        """与 waydroid-cli ping 相同的空操作，经过授权和线程，用来测量每次调用的固定开销"""
+        uid = int(self.bus.get_unix_user(sender))
+        self._dispatch(sender, lambda: ping(uid), reply, error)
+
+def start():
+    dbus.mainloop.glib.DBusGMainLoop(set_as_default=True)
+    loop = GLib.MainLoop()
+    HelperService(loop)
+    loop.run()
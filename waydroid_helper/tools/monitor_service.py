@@ -228,7 +228,8 @@ class Monitor:
 
         try:
             while self.running:
-                ready, _, _ = select.select([self.inotify_fd, self.pipe_r], [], [], 1.0)
+                # 不设超时：退出信号会写管道唤醒 select，空闲时进程不会被周期唤醒
+                ready, _, _ = select.select([self.inotify_fd, self.pipe_r], [], [])
                 if not self.running:
                     break
                 if ready:
@@ -0,0 +1,118 @@
+"""
+扩展安装/卸载操作的批量提权执行
+
+The operations of one install/remove phase are compiled into a batch
+file and run by a single `pkexec waydroid-cli run_batch <file> <sha256>`,
+so a package asks polkit once instead of once per command.
+
+Batch format: one step per line, the action and its arguments separated
+by tabs. Every step is validated here before the file is written, and
+again by waydroid-cli before the first step runs, so a bad step means
+nothing runs at all. The sha256 of the file goes on the pkexec command
+line, which is what polkit authorizes; waydroid-cli copies the file to a
+root-owned temporary file, checks the digest of that copy and executes
+only the copy, so the user-writable cache file cannot be swapped after
+authorization.
+
+waydroid-cli stops at the first failed step and reports the remaining
+steps as skipped. Result lines on stdout:
+    step<TAB>index<TAB>action<TAB>ok|failed|skipped<TAB>returncode|-<TAB>milliseconds
+"""
+
+import hashlib
+import os
+from dataclasses import dataclass
+
+from waydroid_helper.util.log import logger
+
+# action -> (最少参数个数, 最多参数个数, None 表示不限)
+BATCH_ACTIONS: dict[str, tuple[int, int | None]] = {
+    "rm_overlay_rw": (1, None),
+    "rm_data": (1, None),
+    "cp_to_data": (2, 2),
+    "rm_apk": (1, None),
+}
+
+# 这些字符会破坏行/字段的划分
+_FORBIDDEN_CHARS = ("\t", "\n", "\r", "\0")
+
+
+@dataclass
+class BatchStep:
+    action: str
+    args: list[str]
+
+
+@dataclass
+class StepResult:
+    index: int
+    action: str
+    status: str  # "ok", "failed", "skipped"
+    returncode: int | None
+    elapsed_ms: int
+
+
+@dataclass
+class BatchResult:
+    steps: list[StepResult]
+    returncode: int
+    stderr: str
+    elapsed_ms: float
+
+    @property
+    def ok(self) -> bool:
+        return self.returncode == 0 and all(step.status == "ok" for step in self.steps)
+
+
+def validate_step(step: BatchStep) -> bool:
+    limits = BATCH_ACTIONS.get(step.action)
+    if limits is None:
+        logger.error(f"Batch action not allowed: {step.action}")
+        return False
+    min_args, max_args = limits
+    if len(step.args) < min_args or (max_args is not None and len(step.args) > max_args):
+        logger.error(f"Batch action {step.action} got {len(step.args)} arguments")
+        return False
+    for arg in step.args:
+        if not arg or any(char in arg for char in _FORBIDDEN_CHARS):
+            logger.error(f"Invalid argument for batch action {step.action}: {arg!r}")
+            return False
+    return True
+
+
+def serialize(steps: list[BatchStep]) -> bytes:
+    lines = ["\t".join([step.action, *step.args]) for step in steps]
+    return ("\n".join(lines) + "\n").encode()
+
+
+def write_batch(steps: list[BatchStep], directory: str) -> tuple[str, str] | None:
+    """校验并写入批处理文件，返回 (路径, sha256)，有不合法的步骤时返回 None"""
+    if not steps or not all(validate_step(step) for step in steps):
+        return None
+    content = serialize(steps)
+    os.makedirs(directory, exist_ok=True)
+    path = os.path.join(directory, f"batch-{os.getpid()}-{hashlib.sha256(content).hexdigest()[:12]}")
+    with open(path, "wb") as f:
+        f.write(content)
+    return path, hashlib.sha256(content).hexdigest()
+
+
+def parse_results(stdout: str) -> list[StepResult]:
+    results: list[StepResult] = []
+    for line in stdout.splitlines():
+        fields = line.split("\t")
+        if len(fields) != 6 or fields[0] != "step":
+            continue
+        try:
+            results.append(
+                StepResult(
+                    index=int(fields[1]),
+                    action=fields[2],
+                    status=fields[3],
+                    returncode=None if fields[4] == "-" else int(fields[4]),
+                    elapsed_ms=int(fields[5]),
+                )
+            )
+        except ValueError:
+            continue
+    return results
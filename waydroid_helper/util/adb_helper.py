@@ -102,9 +102,12 @@ class AdbHelper:
     async def start_scrcpy_server(self, scid: str) -> bool:
         logger.info("Starting scrcpy-server on device")
         try:
+            # clipboard_autosync=false: 设备剪贴板由 LatencyProbe 的 GET_CLIPBOARD 定期拉取，
+            # 每次回复同时也是一次往返延迟的采样
             server_command = (
                 f"adb -s {self.serial} shell CLASSPATH={SCRCPY_SERVER_PATH_ON_DEVICE} app_process / com.genymobile.scrcpy.Server "
-                f"{SCRCPY_VERSION} scid={scid} log_level=debug video=false audio=false control=true"
+                f"{SCRCPY_VERSION} scid={scid} log_level=debug video=false audio=false control=true "
+                "clipboard_autosync=false"
             )
             await self.sm.run(server_command, flag=True, shell=False)
             logger.info("scrcpy-server start command sent.")
@@ -0,0 +1,226 @@
+"""
+空闲模式与唤醒统计
+
+WakeupCounter counts how often each timer source wakes the process up.
+IdleMonitor switches the process into an idle mode after a period without
+activity; registered participants stop their polling timers and park their
+workers on idle and restart them on the next activity.
+"""
+
+import time
+import weakref
+from typing import Any, Callable
+
+import gi
+
+gi.require_version("GLib", "2.0")
+from gi.repository import GLib
+
+from waydroid_helper.util.log import logger
+
+
+class WakeupCounter:
+    """每个唤醒来源的计数 (单例)"""
+
+    _instance: "WakeupCounter | None" = None
+
+    def __new__(cls):
+        if cls._instance is None:
+            cls._instance = super().__new__(cls)
+            cls._instance._initialized = False
+        return cls._instance
+
+    def __init__(self):
+        if self._initialized:
+            return
+        self._initialized: bool = True
+        self.counts: dict[str, int] = {}
+        self._mark: dict[str, int] = {}
+        self._mark_time: float = time.monotonic()
+
+    def count(self, source: str) -> None:
+        self.counts[source] = self.counts.get(source, 0) + 1
+
+    def since_mark(self) -> tuple[float, dict[str, int]]:
+        """上次 mark() 以来的时长和各来源的唤醒次数"""
+        elapsed = time.monotonic() - self._mark_time
+        delta = {
+            source: count - self._mark.get(source, 0)
+            for source, count in self.counts.items()
+            if count != self._mark.get(source, 0)
+        }
+        return elapsed, delta
+
+    def mark(self) -> None:
+        self._mark = dict(self.counts)
+        self._mark_time = time.monotonic()
+
+    def format_since_mark(self) -> str:
+        elapsed, delta = self.since_mark()
+        total = sum(delta.values())
+        top = sorted(delta.items(), key=lambda item: item[1], reverse=True)[:8]
+        details = ", ".join(f"{source}={count}" for source, count in top)
+        rate = total / elapsed if elapsed > 0 else 0.0
+        return f"{total} wakeups in {elapsed:.1f}s ({rate:.2f}/s){': ' + details if details else ''}"
+
+
+def counted(source: str, callback: Callable[..., Any]) -> Callable[..., Any]:
+    """包装定时器回调，每次触发计一次唤醒"""
+    counter = WakeupCounter()
+
+    def wrapper(*args: Any) -> Any:
+        counter.count(source)
+        return callback(*args)
+
+    return wrapper
+
+
+def callback_source(callback: Callable[..., Any]) -> str:
+    """用回调的限定名作为唤醒来源名"""
+    func = getattr(callback, "__func__", callback)
+    return getattr(func, "__qualname__", type(callback).__name__)
+
+
+class IdleMonitor:
+    """
+    空闲模式 (单例)
+
+    Activity is reported with notify_activity() (input, state events) or
+    held with hold()/release() (a focused window, a running operation).
+    IDLE_TIMEOUT seconds after the last activity with no holds, every
+    participant's on_idle runs; the next activity runs on_active. While
+    active, the check is a single one-shot timer re-armed only when it
+    fires, so input does not add timer churn; while idle, it has no timer
+    at all.
+
+    Participants given as bound methods are held weakly, the same way
+    EventBus holds subscribers, so a deleted widget drops out by itself.
+    """
+
+    IDLE_TIMEOUT = 10.0
+
+    _instance: "IdleMonitor | None" = None
+
+    def __new__(cls):
+        if cls._instance is None:
+            cls._instance = super().__new__(cls)
+            cls._instance._initialized = False
+        return cls._instance
+
+    def __init__(self):
+        if self._initialized:
+            return
+        self._initialized: bool = True
+
+        self.idle: bool = False
+        self.timeout: float = self.IDLE_TIMEOUT
+        self._holds: int = 0
+        self._last_activity: float = time.monotonic()
+        self._source_id: int | None = None
+        self._participants: dict[
+            int, tuple[Callable[[], Any] | None, Callable[[], Any] | None]
+        ] = {}
+        self._next_id: int = 1
+        self._started: bool = False
+
+    @staticmethod
+    def _ref(callback: Callable[[], None] | None) -> Callable[[], Any] | None:
+        if callback is None:
+            return None
+        try:
+            return weakref.WeakMethod(callback)  # type: ignore[arg-type]
+        except TypeError:
+            return lambda: callback
+
+    def register(
+        self,
+        on_idle: Callable[[], None] | None = None,
+        on_active: Callable[[], None] | None = None,
+    ) -> int:
+        """注册空闲/恢复回调，返回注册 ID"""
+        participant_id = self._next_id
+        self._next_id += 1
+        self._participants[participant_id] = (self._ref(on_idle), self._ref(on_active))
+        return participant_id
+
+    def unregister(self, participant_id: int | None) -> None:
+        if participant_id is not None:
+            self._participants.pop(participant_id, None)
+
+    def start(self) -> None:
+        if self._started:
+            return
+        self._started = True
+        self._last_activity = time.monotonic()
+        WakeupCounter().mark()
+        self._arm(self.timeout)
+
+    def notify_activity(self, source: str = "input") -> None:
+        self._last_activity = time.monotonic()
+        if self.idle:
+            self._leave_idle(source)
+        elif self._source_id is None and self._started and self._holds == 0:
+            self._arm(self.timeout)
+
+    def hold(self) -> None:
+        """保持活跃状态，直到对应的 release()"""
+        self._holds += 1
+        self.notify_activity("hold")
+
+    def release(self) -> None:
+        self._holds = max(0, self._holds - 1)
+        self.notify_activity("release")
+
+    def _arm(self, delay: float) -> None:
+        if self._source_id is not None:
+            return
+        self._source_id = GLib.timeout_add(
+            max(1, int(delay * 1000)), counted("IdleMonitor._check", self._check)
+        )
+
+    def _check(self) -> bool:
+        self._source_id = None
+        if self._holds > 0:
+            # 释放时会重新计时
+            return False
+        remaining = self._last_activity + self.timeout - time.monotonic()
+        if remaining > 0:
+            self._arm(remaining)
+        else:
+            self._enter_idle()
+        return False
+
+    def _run_participants(self, index: int) -> None:
+        for participant_id, callbacks in list(self._participants.items()):
+            ref = callbacks[index]
+            if ref is None:
+                continue
+            callback = ref()
+            if callback is None:
+                # 所属对象已被回收
+                self._participants.pop(participant_id, None)
+                continue
+            try:
+                callback()
+            except Exception as e:
+                logger.error(f"Idle participant failed: {e}")
+
+    def _enter_idle(self) -> None:
+        self.idle = True
+        logger.debug(f"Entering idle mode, active period: {WakeupCounter().format_since_mark()}")
+        WakeupCounter().mark()
+        self._run_participants(0)
+
+    def _leave_idle(self, source: str) -> None:
+        self.idle = False
+        logger.debug(f"Leaving idle mode on {source}, idle period: {WakeupCounter().format_since_mark()}")
+        WakeupCounter().mark()
+        self._run_participants(1)
+        if self._holds == 0:
+            self._arm(self.timeout)
+
+    @classmethod
+    def reset_singleton(cls) -> None:
+        if cls._instance is not None and cls._instance._source_id is not None:
+            GLib.source_remove(cls._instance._source_id)
+        cls._instance = None
@@ -0,0 +1,205 @@
+"""
+提权操作
+
+Privileged verbs go to the id.waydro.Helper service when it is installed
+(see tools/helper_service.py) and fall back to `pkexec waydroid-cli <verb>`
+when it is not. Either way the caller gets a SubprocessResult, or a
+SubprocessError when the verb fails, so call sites do not care which path
+ran.
+
+Each call's latency is logged at debug level with the path it took;
+benchmark() compares the authorized no-op verb ping through both paths.
+"""
+
+import asyncio
+import os
+import shlex
+import subprocess
+import time
+from typing import Any
+
+import dbus
+import dbus.mainloop.glib
+
+from waydroid_helper.util.log import logger
+from waydroid_helper.util.subprocess_manager import (SubprocessError,
+                                                     SubprocessManager,
+                                                     SubprocessResult)
+
+BUS_NAME = "id.waydro.Helper"
+OBJECT_PATH = "/org/waydro/Helper"
+
+# verb -> 服务方法名
+HELPER_METHODS: dict[str, str] = {
+    "copy_to_var": "CopyToVar",
+    "install": "Install",
+    "get_android_id": "GetAndroidId",
+    "restart_container": "RestartContainer",
+    "ping": "Ping",
+}
+
+# 这些错误表示服务不可用，改用 pkexec
+_UNAVAILABLE_ERRORS = (
+    "org.freedesktop.DBus.Error.ServiceUnknown",
+    "org.freedesktop.DBus.Error.NameHasNoOwner",
+    "org.freedesktop.DBus.Error.Spawn",
+    "org.freedesktop.DBus.Error.AccessDenied",
+    "org.freedesktop.DBus.Error.UnknownMethod",
+    "org.freedesktop.DBus.Error.FileNotFound",
+    "org.freedesktop.DBus.Error.NoServer",
+)
+
+
+class PrivilegedHelper:
+    """提权操作入口 (单例)"""
+
+    CALL_TIMEOUT = 300
+
+    _instance: "PrivilegedHelper | None" = None
+
+    def __new__(cls):
+        if cls._instance is None:
+            cls._instance = super().__new__(cls)
+            cls._instance._initialized = False
+        return cls._instance
+
+    def __init__(self):
+        if self._initialized:
+            return
+        self._initialized: bool = True
+        self._subprocess = SubprocessManager()
+        self._interface: dbus.Interface | None = None
+        # 服务不可用时本次运行不再尝试
+        self.available: bool = True
+        # (verb, "helper" | "pkexec") -> 每次调用的毫秒数
+        self.latencies: dict[tuple[str, str], list[float]] = {}
+
+    def _get_interface(self) -> dbus.Interface:
+        if self._interface is None:
+            # 独立连接：共享连接可能没有主循环，收不到异步回复；
+            # 服务按连接缓存授权，这个连接在本次运行中一直保留
+            bus = dbus.SystemBus(private=True, mainloop=dbus.mainloop.glib.DBusGMainLoop())
+            self._interface = dbus.Interface(bus.get_object(BUS_NAME, OBJECT_PATH), BUS_NAME)
+        return self._interface
+
+    async def run(self, verb: str, *args: str | int) -> SubprocessResult:
+        """执行一个 waydroid-cli 提权操作，失败时抛出 SubprocessError"""
+        if self.available and verb in HELPER_METHODS:
+            try:
+                return await self._timed(verb, "helper", self._call_helper(verb, args))
+            except dbus.DBusException as e:
+                name = e.get_dbus_name() or ""
+                if name == "id.waydro.Helper.NotAuthorized":
+                    # 与 pkexec 认证被拒绝时的返回码相同
+                    raise SubprocessError(126, str(e).encode())
+                if not name.startswith(_UNAVAILABLE_ERRORS):
+                    raise SubprocessError(1, str(e).encode())
+                logger.info(f"Privileged helper unavailable ({name}), using pkexec")
+                self.available = False
+                self._interface = None
+
+        command = " ".join(
+            ["pkexec", shlex.quote(os.environ["WAYDROID_CLI_PATH"]), verb]
+            + [shlex.quote(str(arg)) for arg in args]
+        )
+        return await self._timed(verb, "pkexec", self._subprocess.run(command, flag=True, shell=False))
+
+    async def _timed(self, verb: str, via: str, call: Any) -> SubprocessResult:
+        start = time.monotonic()
+        result = await call
+        elapsed = (time.monotonic() - start) * 1000
+        self.latencies.setdefault((verb, via), []).append(elapsed)
+        logger.debug(f"Privileged {verb} via {via}: {elapsed:.1f}ms")
+        return result
+
+    async def _call_helper(self, verb: str, args: tuple[str | int, ...]) -> SubprocessResult:
+        loop = asyncio.get_running_loop()
+        future: asyncio.Future[Any] = loop.create_future()
+
+        def reply(result: Any) -> None:
+            if not future.done():
+                future.set_result(result)
+
+        def error(e: Exception) -> None:
+            if not future.done():
+                future.set_exception(e)
+
+        dbus_args = [dbus.UInt32(arg) if isinstance(arg, int) else dbus.String(arg) for arg in args]
+        getattr(self._get_interface(), HELPER_METHODS[verb])(
+            *dbus_args,
+            reply_handler=reply,
+            error_handler=error,
+            timeout=self.CALL_TIMEOUT,
+        )
+        response = await future
+
+        command = " ".join([verb, *(str(arg) for arg in args)])
+        result: SubprocessResult = {
+            "command": command,
+            "key": command,
+            "returncode": int(response.get("returncode", 1)),
+            "stdout": str(response.get("stdout", "")),
+            "stderr": str(response.get("stderr", "")),
+            "process": None,
+        }
+        if result["returncode"] != 0:
+            raise SubprocessError(
+                result["returncode"], result["stderr"].encode(), result["stdout"].encode()
+            )
+        return result
+
+    def latency_summary(self) -> str:
+        lines: list[str] = []
+        for (verb, via), samples in sorted(self.latencies.items()):
+            lines.append(
+                f"{verb} via {via}: mean {sum(samples) / len(samples):.1f}ms, "
+                f"min {min(samples):.1f}ms, n={len(samples)}"
+            )
+        return "\n".join(lines) or "no privileged calls"
+
+
+def benchmark(rounds: int = 10) -> str:
+    """
+    比较授权后的空操作经由服务和 pkexec 的往返时间
+
+    Both sides run the ping verb: the helper's Ping goes through the same
+    polkit check and worker thread as the other verbs, the pkexec side is
+    `pkexec waydroid-cli ping`. Both measure the per-call overhead on top
+    of the actual work. The first round of each may ask for the password
+    and is left out.
+    """
+    cli_path = os.environ.get("WAYDROID_CLI_PATH", "waydroid-cli")
+    report: list[str] = []
+
+    def stats(name: str, samples: list[float]) -> str:
+        ordered = sorted(samples)
+        return (
+            f"{name}: median {ordered[len(ordered) // 2]:.2f}ms, "
+            f"min {ordered[0]:.2f}ms, max {ordered[-1]:.2f}ms, n={len(ordered)}"
+        )
+
+    try:
+        interface = dbus.Interface(dbus.SystemBus().get_object(BUS_NAME, OBJECT_PATH), BUS_NAME)
+        # 激活服务并完成授权，授权按连接缓存
+        interface.Ping(timeout=PrivilegedHelper.CALL_TIMEOUT)
+        samples: list[float] = []
+        for _ in range(rounds):
+            start = time.perf_counter()
+            interface.Ping(timeout=PrivilegedHelper.CALL_TIMEOUT)
+            samples.append((time.perf_counter() - start) * 1000)
+        report.append(stats("helper", samples))
+    except dbus.DBusException as e:
+        report.append(f"helper: unavailable ({e.get_dbus_name()})")
+
+    samples = []
+    for index in range(rounds + 1):
+        start = time.perf_counter()
+        result = subprocess.run(["pkexec", cli_path, "ping"], capture_output=True)
+        if result.returncode != 0:
+            report.append(f"pkexec: failed with {result.returncode}")
+            break
+        if index > 0:
+            samples.append((time.perf_counter() - start) * 1000)
+    if samples:
+        report.append(stats("pkexec", samples))
+    return "\n".join(report)
@@ -0,0 +1,83 @@
+import asyncio
+import time
+from collections.abc import Callable, Coroutine
+from typing import Any
+
+from waydroid_helper.util.log import logger
+
+
+class StartupLoader:
+    """
+    依赖图驱动的启动加载器
+
+    Each phase starts as soon as all phases it depends on have finished, so
+    independent phases run concurrently. A failing phase is logged and its
+    dependents are skipped; unrelated phases keep running.
+    """
+
+    def __init__(self, name: str = "startup"):
+        self.name: str = name
+        self._phases: dict[str, Callable[[], Coroutine[Any, Any, Any]]] = {}
+        self._dependencies: dict[str, tuple[str, ...]] = {}
+        self.timings: dict[str, float] = {}
+
+    def add_phase(
+        self,
+        name: str,
+        loader: Callable[[], Coroutine[Any, Any, Any]],
+        depends_on: tuple[str, ...] = (),
+    ) -> "StartupLoader":
+        """
+        添加一个加载阶段
+
+        Args:
+            name: Phase name, used for dependencies and timings
+            loader: Coroutine function performing the load
+            depends_on: Names of phases that must succeed first
+        """
+        if name in self._phases:
+            raise ValueError(f"Duplicate startup phase: {name}")
+        for dependency in depends_on:
+            if dependency not in self._phases:
+                raise ValueError(f"Unknown dependency {dependency} for phase {name}")
+
+        self._phases[name] = loader
+        self._dependencies[name] = depends_on
+        return self
+
+    async def run(self) -> dict[str, float]:
+        """
+        运行所有阶段
+
+        Returns:
+            Phase name -> duration in milliseconds, for phases that succeeded
+        """
+        self.timings = {}
+        start = time.perf_counter()
+        tasks: dict[str, asyncio.Task[bool]] = {}
+
+        async def run_phase(name: str) -> bool:
+            for dependency in self._dependencies[name]:
+                if not await tasks[dependency]:
+                    logger.debug(f"[{self.name}] Skipping {name}: {dependency} failed")
+                    return False
+
+            phase_start = time.perf_counter()
+            try:
+                await self._phases[name]()
+            except Exception as e:
+                logger.error(f"[{self.name}] Phase {name} failed: {e}")
+                return False
+
+            self.timings[name] = (time.perf_counter() - phase_start) * 1000
+            return True
+
+        # Dependencies are registered before dependents, so every awaited task exists
+        for name in self._phases:
+            tasks[name] = asyncio.create_task(run_phase(name))
+        await asyncio.gather(*tasks.values())
+
+        total = (time.perf_counter() - start) * 1000
+        summary = ", ".join(f"{name}={ms:.1f}ms" for name, ms in self.timings.items())
+        logger.info(f"[{self.name}] Finished in {total:.1f}ms ({summary})")
+        return self.timings
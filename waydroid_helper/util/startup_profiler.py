@@ -0,0 +1,110 @@
+import json
+import os
+import time
+from collections.abc import Iterator
+from contextlib import contextmanager
+from typing import Any
+
+from waydroid_helper.util.log import logger
+
+# The launcher stores time.monotonic() here before importing anything heavy
+LAUNCH_TIME_ENV = "WAYDROID_HELPER_LAUNCH_TIME"
+REPORT_FILE = "startup-report.json"
+
+
+class StartupProfiler:
+    """
+    启动耗时统计
+
+    Records named phases (mostly imports and page construction) and the time
+    from process launch to the first painted frame, then writes them to a
+    JSON report in the user cache directory.
+    """
+
+    _instance: "StartupProfiler | None" = None
+
+    def __new__(cls):
+        if cls._instance is None:
+            cls._instance = super().__new__(cls)
+            cls._instance._initialized = False
+        return cls._instance
+
+    def __init__(self):
+        if self._initialized:
+            return
+        self._initialized: bool = True
+
+        try:
+            self.launch_time: float = float(os.environ[LAUNCH_TIME_ENV])
+        except (KeyError, ValueError):
+            self.launch_time = time.monotonic()
+        self.phases: dict[str, float] = {}
+        self.first_frame_ms: float | None = None
+
+    def elapsed_ms(self) -> float:
+        return (time.monotonic() - self.launch_time) * 1000
+
+    @contextmanager
+    def phase(self, name: str) -> Iterator[None]:
+        """统计一个阶段的耗时（毫秒）"""
+        start = time.monotonic()
+        try:
+            yield
+        finally:
+            self.phases[name] = (time.monotonic() - start) * 1000
+
+    def watch_first_frame(self, window: Any) -> None:
+        """
+        在窗口第一次绘制后记录耗时并写出报告
+
+        Args:
+            window: A Gtk.Window that is about to be presented
+        """
+        if self.first_frame_ms is not None:
+            return
+
+        handler_ids: list[int] = []
+
+        def on_after_paint(frame_clock: Any) -> None:
+            if self.first_frame_ms is None:
+                self.first_frame_ms = self.elapsed_ms()
+                logger.info(f"First frame after {self.first_frame_ms:.1f}ms")
+                self.write_report()
+            for handler_id in handler_ids:
+                frame_clock.disconnect(handler_id)
+            handler_ids.clear()
+
+        def on_realize(widget: Any) -> None:
+            frame_clock = widget.get_frame_clock()
+            if frame_clock is not None:
+                handler_ids.append(frame_clock.connect("after-paint", on_after_paint))
+
+        if window.get_realized():
+            on_realize(window)
+        else:
+            window.connect("realize", on_realize)
+
+    def get_report(self) -> dict[str, Any]:
+        return {
+            "first_frame_ms": self.first_frame_ms,
+            "phases_ms": dict(self.phases),
+        }
+
+    def write_report(self) -> str | None:
+        """写出启动报告，返回报告路径"""
+        from gi.repository import GLib
+
+        report_dir = os.path.join(GLib.get_user_cache_dir(), "waydroid-helper")
+        report_path = os.path.join(report_dir, REPORT_FILE)
+        try:
+            os.makedirs(report_dir, exist_ok=True)
+            with open(report_path, "w", encoding="utf-8") as f:
+                json.dump(self.get_report(), f, indent=2)
+            logger.debug(f"Startup report written to {report_path}")
+            return report_path
+        except OSError as e:
+            logger.warning(f"Failed to write startup report: {e}")
+            return None
+
+
+profiler = StartupProfiler()
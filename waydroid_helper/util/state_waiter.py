@@ -6,12 +6,33 @@ gi.require_version("Gtk", "4.0")
 gi.require_version("Adw", "1")
 
 from gi.repository import GObject
-from typing import Any
+from typing import Any, Protocol
+
+
+class StateNotifier(Protocol):
+    """
+    状态变化的即时通知源
+
+    While acquired, the notifier keeps the watched properties fresh so waiters
+    wake up as soon as the state actually changes, instead of on the next
+    periodic poll.
+    """
+
+    def acquire(self) -> None: ...
+
+    def release(self) -> None: ...
+
 
 class StateWaiter:
     """优雅的状态等待工具类 - 支持并发和复用"""
     
-    def __init__(self, gobject_instance: GObject.Object, target_state: Any, state_property: str = "state"):
+    def __init__(
+        self,
+        gobject_instance: GObject.Object,
+        target_state: Any,
+        state_property: str = "state",
+        notifier: StateNotifier | None = None,
+    ):
         """
         初始化状态等待器
         
@@ -19,12 +40,15 @@ class StateWaiter:
             gobject_instance: 支持 GObject 信号的实例 
             target_state: 目标状态
             state_property: 状态属性名，默认为 "state"
+            notifier: 等待期间启用的即时通知源
         """
         self.gobject_instance: GObject.Object = gobject_instance
         self.target_state = target_state
         self.state_property = state_property
+        self.notifier = notifier
         self._event = asyncio.Event()
         self._signal_id = None
+        self._notifier_acquired = False
         
     async def __aenter__(self):
         """异步上下文管理器入口"""
@@ -45,12 +69,18 @@ class StateWaiter:
         current_state = self.gobject_instance.get_property(self.state_property)
         if current_state == self.target_state:
             self._event.set()
+        elif self.notifier is not None:
+            self.notifier.acquire()
+            self._notifier_acquired = True
     
     def _cleanup_listener(self):
         """清理状态监听器"""
         if self._signal_id is not None:
             self.gobject_instance.disconnect(self._signal_id)
             self._signal_id = None
+        if self.notifier is not None and self._notifier_acquired:
+            self.notifier.release()
+            self._notifier_acquired = False
     
     def _on_state_changed(self, instance: GObject.Object, param: Any):
         """处理状态变化"""
@@ -66,7 +96,13 @@ class StateWaiter:
             return False
 
 async def wait_for_state(
-    gobject_instance, target_state, timeout: float = 30.0, state_property: str = "state"
+    gobject_instance,
+    target_state,
+    timeout: float = 30.0,
+    state_property: str = "state",
+    notifier: StateNotifier | None = None,
 ) -> bool:
-    async with StateWaiter(gobject_instance, target_state, state_property) as waiter:
+    async with StateWaiter(
+        gobject_instance, target_state, state_property, notifier
+    ) as waiter:
         return await waiter.wait(timeout)
\ No newline at end of file
@@ -15,9 +15,10 @@ class SubprocessResult(TypedDict):
     process: asyncio.subprocess.Process | None
 
 class SubprocessError(Exception):
-    def __init__(self, returncode: int, stderr: bytes):
+    def __init__(self, returncode: int, stderr: bytes, stdout: bytes = b""):
         self.returncode: int = returncode
         self.stderr: bytes = stderr
+        self.stdout: bytes = stdout
         super().__init__(
             f"Command failed with return code {returncode}: {stderr.decode()}"
         )
@@ -121,6 +122,6 @@ class SubprocessManager:
             #     )
             # )
             if result["returncode"] != 0:
-                raise SubprocessError(result["returncode"], stderr)
+                raise SubprocessError(result["returncode"], stderr, stdout)
 
             return result
@@ -6,25 +6,267 @@
 # pyright: reportUnknownMemberType=false
 
 import asyncio
-from collections.abc import Coroutine
+import time
+import weakref
+from collections.abc import Coroutine, Generator
 from typing import Any, TypeVar
 
+from waydroid_helper.util.log import logger
+
 T = TypeVar('T')
 
+
+class _TimedCoroutine(Coroutine[Any, Any, T]):
+    """包装协程，累计每一步占用的 CPU 时间"""
+
+    def __init__(self, coro: Coroutine[Any, Any, T], record: "_TaskRecord"):
+        self._coro = coro
+        self._record = record
+        self.__name__ = getattr(coro, "__name__", type(coro).__name__)
+        self.__qualname__ = getattr(coro, "__qualname__", self.__name__)
+
+    def send(self, value: Any) -> Any:
+        start = time.thread_time()
+        try:
+            return self._coro.send(value)
+        finally:
+            self._record.add_cpu_time(time.thread_time() - start)
+
+    def throw(self, *args: Any) -> Any:
+        start = time.thread_time()
+        try:
+            return self._coro.throw(*args)
+        finally:
+            self._record.add_cpu_time(time.thread_time() - start)
+
+    def close(self) -> None:
+        self._coro.close()
+
+    def __await__(self) -> Generator[Any, None, T]:
+        return self._coro.__await__()
+
+
+class _TaskRecord:
+    __slots__ = ("scope", "name", "started", "cpu_time")
+
+    def __init__(self, scope: "TaskScope", name: str):
+        self.scope = scope
+        self.name = name
+        self.started = time.monotonic()
+        self.cpu_time = 0.0
+
+    def add_cpu_time(self, seconds: float) -> None:
+        self.cpu_time += seconds
+        self.scope.cpu_time += seconds
+
+
+class TaskScope:
+    """
+    任务作用域
+
+    Tasks created through a scope are tracked until they finish and are
+    cancelled when the scope is closed; closing a scope also closes its
+    child scopes. A scope remembers its owner only weakly, so a scope whose
+    owner was collected without close() shows up as orphaned in the
+    supervisor report instead of being kept alive by it.
+
+    Named tasks can be replaced: create_task(..., name=n) cancels the live
+    task with the same name first, which is what the widgets did by hand
+    with their _current_task fields.
+    """
+
+    def __init__(self, name: str, owner: Any = None, parent: "TaskScope | None" = None):
+        self.name = name
+        self.parent = parent
+        self.children: list[TaskScope] = []
+        self.cpu_time: float = 0.0
+        self.created: int = 0
+        self.closed: bool = False
+        self._tasks: dict[asyncio.Task[Any], _TaskRecord] = {}
+        self._named: dict[str, asyncio.Task[Any]] = {}
+        self._owner = weakref.ref(owner) if owner is not None else None
+        if parent is not None:
+            parent.children.append(self)
+
+    @property
+    def live_count(self) -> int:
+        return len(self._tasks)
+
+    @property
+    def owner_alive(self) -> bool:
+        return self._owner is None or self._owner() is not None
+
+    def child(self, name: str, owner: Any = None) -> "TaskScope":
+        return TaskSupervisor().scope(name, owner=owner, parent=self)
+
+    def create_task(
+        self, coro: Coroutine[Any, Any, T], name: str | None = None
+    ) -> asyncio.Task[T]:
+        """在作用域内创建任务；给出 name 时先取消同名的旧任务"""
+        if name is not None:
+            self.cancel(name)
+        record = _TaskRecord(self, name or getattr(coro, "__qualname__", "task"))
+        task = asyncio.create_task(_TimedCoroutine(coro, record))
+        self.created += 1
+        self._tasks[task] = record
+        if name is not None:
+            self._named[name] = task
+        task.add_done_callback(self._on_task_done)
+        if self.closed:
+            # 作用域已关闭：任务不会开始执行
+            logger.warning(f"Task {record.name} created in closed scope {self.name}")
+            task.cancel()
+        return task
+
+    def get(self, name: str) -> asyncio.Task[Any] | None:
+        task = self._named.get(name)
+        return task if task is not None and not task.done() else None
+
+    def is_running(self, name: str) -> bool:
+        return self.get(name) is not None
+
+    def cancel(self, name: str) -> bool:
+        """取消同名任务，返回是否有任务被取消"""
+        task = self._named.pop(name, None)
+        if task is None or task.done():
+            return False
+        task.cancel()
+        return True
+
+    def cancel_all(self) -> None:
+        for task in list(self._tasks):
+            task.cancel()
+
+    def close(self) -> None:
+        """取消所有任务并关闭子作用域"""
+        if self.closed:
+            return
+        self.closed = True
+        for child in list(self.children):
+            child.close()
+        self.cancel_all()
+        TaskSupervisor()._on_scope_closed(self)
+
+    def _on_task_done(self, task: asyncio.Task[Any]) -> None:
+        record = self._tasks.pop(task, None)
+        if record is not None and self._named.get(record.name) is task:
+            del self._named[record.name]
+        if self.closed and not self._tasks:
+            # 关闭后最后一个任务结束，监督器不再需要跟踪这个作用域
+            TaskSupervisor()._on_scope_drained(self)
+        if task.cancelled():
+            return
+        exc = task.exception()
+        if exc is not None:
+            logger.error(f"Task {self.name}/{record.name if record else task.get_name()} failed: {exc!r}")
+
+    def task_records(self) -> list[tuple[asyncio.Task[Any], _TaskRecord]]:
+        return list(self._tasks.items())
+
+
+class TaskSupervisor:
+    """
+    任务监督器 (单例)
+
+    Keeps every open TaskScope plus the closed ones that still have live
+    tasks; a closed scope is dropped when its last task finishes. It can
+    report tasks that run longer than a threshold or belong
+    to a closed scope or a collected owner.
+    """
+
+    _instance: 'TaskSupervisor|None' = None
+
+    def __new__(cls):
+        if cls._instance is None:
+            cls._instance = super().__new__(cls)
+            cls._instance._initialized = False
+        return cls._instance
+
+    def __init__(self):
+        if self._initialized:
+            return
+        self._initialized: bool = True
+        self._scopes: set[TaskScope] = set()
+        self.root: TaskScope = TaskScope("app")
+        self._scopes.add(self.root)
+
+    def scope(
+        self, name: str, owner: Any = None, parent: TaskScope | None = None
+    ) -> TaskScope:
+        """创建一个作用域，默认挂在根作用域下"""
+        scope = TaskScope(name, owner=owner, parent=parent or self.root)
+        self._scopes.add(scope)
+        return scope
+
+    def _on_scope_closed(self, scope: TaskScope) -> None:
+        if scope.parent is not None and scope in scope.parent.children:
+            scope.parent.children.remove(scope)
+        if scope.live_count == 0:
+            self._scopes.discard(scope)
+
+    def _on_scope_drained(self, scope: TaskScope) -> None:
+        """已关闭的作用域的最后一个任务结束"""
+        self._scopes.discard(scope)
+
+    def scopes(self) -> list[TaskScope]:
+        # 已关闭或所有者已回收、且没有存活任务的作用域不再需要跟踪
+        for scope in [
+            s for s in self._scopes
+            if (s.closed or not s.owner_alive) and s.live_count == 0
+        ]:
+            self._scopes.discard(scope)
+            if scope.parent is not None and scope in scope.parent.children:
+                scope.parent.children.remove(scope)
+        return sorted(self._scopes, key=lambda s: s.name)
+
+    def report(self, long_running: float = 30.0) -> list[str]:
+        """
+        调试报告
+
+        Returns one line per scope with its live task count and CPU time,
+        followed by the tasks that are older than long_running seconds or
+        orphaned (scope closed or owner collected while the task lives).
+        """
+        now = time.monotonic()
+        lines: list[str] = []
+        for scope in self.scopes():
+            state = "closed" if scope.closed else "open"
+            lines.append(
+                f"{scope.name} [{state}]: {scope.live_count} live / {scope.created} created, "
+                f"cpu {scope.cpu_time * 1000:.1f}ms"
+            )
+            orphaned_scope = scope.closed or not scope.owner_alive
+            for task, record in scope.task_records():
+                age = now - record.started
+                if orphaned_scope:
+                    lines.append(f"  orphaned: {record.name} age {age:.1f}s cpu {record.cpu_time * 1000:.1f}ms")
+                elif age >= long_running:
+                    lines.append(f"  long-running: {record.name} age {age:.1f}s cpu {record.cpu_time * 1000:.1f}ms")
+        return lines
+
+    def log_report(self, long_running: float = 30.0) -> None:
+        for line in self.report(long_running):
+            logger.info(line)
+
+    @classmethod
+    def reset_singleton(cls) -> None:
+        if cls._instance is not None:
+            cls._instance.root.close()
+        cls._instance = None
+
+
 class Task:
     _instance: 'Task|None' = None
-    background_tasks: set[asyncio.Task[Any]]|None = None
 
     def __new__(cls, *args, **kwargs):
         if cls._instance is None:
             cls._instance = super(Task, cls).__new__(cls, *args, **kwargs)
-            cls._instance.background_tasks = set()
         return cls._instance
 
+    @property
+    def background_tasks(self) -> set[asyncio.Task[Any]]:
+        return {task for task, _record in TaskSupervisor().root.task_records()}
+
     def create_task(self, coro: Coroutine[Any, Any, T]) -> asyncio.Task[T]:
-        if self.background_tasks is None:
-            self.background_tasks = set()
-        task = asyncio.create_task(coro)
-        self.background_tasks.add(task)
-        task.add_done_callback(self.background_tasks.discard)
-        return task
+        # 后台任务归根作用域管理，保留强引用直到完成
+        return TaskSupervisor().root.create_task(coro)
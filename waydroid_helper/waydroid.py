@@ -11,7 +11,7 @@ from typing import Any
 
 from gi.repository import GLib, GObject
 
-from waydroid_helper.util import SubprocessError, SubprocessManager, Task, logger
+from waydroid_helper.util import SubprocessError, SubprocessManager, Task
 
 CONFIG_PATH = os.environ.get("WAYDROID_CONFIG", "/var/lib/waydroid/waydroid.cfg")
 
@@ -158,10 +158,7 @@ class PrivilegedPropsCompat(GObject.Object):
 
     async def save(self):
         """Save properties (compatibility method)"""
-        success = await self._controller.save_all_privileged_properties()
-        if success:
-            return await self._controller.upgrade(offline=True)
-        return False
+        return await self._controller.save_all_privileged_properties(upgrade=True)
 
     async def restore(self):
         """Restore properties (compatibility method)"""
@@ -262,6 +259,11 @@ class WaydroidCompat(GObject.Object):
         """Compatibility property for waydroid config props"""
         return self._waydroid_props_compat
 
+    @property
+    def state_notifier(self):
+        """Notifier that keeps session and boot state fresh while waiting on them"""
+        return self._controller.state_notifier
+
     # Session management methods (delegate to controller)
     async def start_session(self):
         """Start Waydroid session"""
@@ -302,10 +304,7 @@ class WaydroidCompat(GObject.Object):
 
     async def save_privileged_props(self):
         """Save privileged properties"""
-        success = await self._controller.save_all_privileged_properties()
-        if success:
-            return await self._controller.upgrade(offline=True)
-        return False
+        return await self._controller.save_all_privileged_properties(upgrade=True)
 
     async def restore_privileged_props(self):
         """Restore privileged properties"""
@@ -313,11 +312,7 @@ class WaydroidCompat(GObject.Object):
 
     async def save_waydroid_props(self, upgrade: bool = False):
         """Save waydroid config properties"""
-        success = await self._controller.save_all_waydroid_properties()
-        if success and upgrade:
-            logger.debug("Upgrade waydroid config properties")
-            return await self._controller.upgrade(offline=True)
-        return success
+        return await self._controller.save_all_waydroid_properties(upgrade=upgrade)
 
     async def reset_waydroid_props(self):
         """Reset waydroid config properties"""
@@ -17,6 +17,7 @@ from waydroid_helper.compat_widget import (ADW_VERSION, HeaderBar,
                                            NavigationPage, NavigationView,
                                            ToolbarView)
 from waydroid_helper.util import template
+from waydroid_helper.util.idle import IdleMonitor
 
 from .general_page import GeneralPage
 
@@ -143,3 +144,15 @@ class WaydroidHelperWindow(Adw.ApplicationWindow):
             title=_("Home"),
             icon_name="home-symbolic",
         )
+
+        # 窗口处于活动状态时不进入空闲模式
+        self._idle_held = False
+        self.connect("notify::is-active", self._on_is_active_changed)
+
+    def _on_is_active_changed(self, *_args):
+        active = self.is_active()
+        if active and not self._idle_held:
+            IdleMonitor().hold()
+        elif not active and self._idle_held:
+            IdleMonitor().release()
+        self._idle_held = active